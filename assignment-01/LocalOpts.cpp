@@ -1,28 +1,38 @@
 #include "LocalOpts.h"
+#include "SCCP.h"
+
+#include "llvm/ADT/Statistic.h"
 using namespace llvm;
 
+#define DEBUG_TYPE "local-opts"
+
+STATISTIC(NumAlgebraicIdentities, "Operations by their neutral element removed");
+STATISTIC(NumStrengthReductions, "Multiplications and divisions by a power of 2 turned into shifts");
+STATISTIC(NumAdvancedStrengthReductions, "Multiplications by 2^n +- 1 turned into a shift and an add");
+STATISTIC(NumMultiInstructions, "Pairs of opposite operations folded");
+
 PreservedAnalyses LocalOpts::run(Function &F, FunctionAnalysisManager &FAM) {
-  errs() << "\nRunning on function: " << F.getName() << "\n";
+  auto &ORE = FAM.getResult<OptimizationRemarkEmitterAnalysis>(F);
   bool functionChanged = false;
 
   for (auto &BB : F)
-    functionChanged |= runOnBasicBlock(BB);
+    functionChanged |= runOnBasicBlock(BB, &ORE);
 
   return functionChanged ? PreservedAnalyses::none() : PreservedAnalyses::all();
 }
 
-bool LocalOpts::runOnBasicBlock(BasicBlock &B) {
+bool LocalOpts::runOnBasicBlock(BasicBlock &B, OptimizationRemarkEmitter *ORE) {
   bool blockChanged = false;
   std::set<Instruction*> toBeErased;
 
   for (auto &I : B) {
     bool instructionChanged = 
       I.isBinaryOp() &&
-      AlgebraicIdentityOpt(I) || 
-      MultiInstructionOpt(I) ||
-      SubMultiInstrOpt(I) ||
-      StrengthReductionOpt(I) ||
-      AdvancedMulSROpt(I);
+      AlgebraicIdentityOpt(I, ORE) || 
+      MultiInstructionOpt(I, ORE) ||
+      SubMultiInstrOpt(I, ORE) ||
+      StrengthReductionOpt(I, ORE) ||
+      AdvancedMulSROpt(I, ORE);
 
     if (instructionChanged) 
       toBeErased.insert(&I);
@@ -36,9 +46,9 @@ bool LocalOpts::runOnBasicBlock(BasicBlock &B) {
   return blockChanged;
 }
 
-bool LocalOpts::AlgebraicIdentityOpt(Instruction &I) {
+bool LocalOpts::AlgebraicIdentityOpt(Instruction &I, OptimizationRemarkEmitter *ORE) {
   // opcode -> {neutral constant value, isCommutative}
-  const std::unordered_map<unsigned, std::pair<unsigned, bool>> operations = {
+  static const std::unordered_map<unsigned, std::pair<unsigned, bool>> operations = {
     {Instruction::Add, {0, true}}, 
     {Instruction::Mul, {1, true}},   
     {Instruction::Sub, {0, false}}, 
@@ -65,14 +75,18 @@ bool LocalOpts::AlgebraicIdentityOpt(Instruction &I) {
   if (isCommutative && isNeutral(LHS)) std::swap(LHS, RHS);
   if (!isNeutral(RHS)) return false;
 
-  errs() << "Algebraic Identity: " << I << "\n";
+  ++NumAlgebraicIdentities;
+  if (ORE) ORE->emit([&] {
+    return OptimizationRemark(DEBUG_TYPE, "AlgebraicIdentity", &I)
+           << ore::NV("Inst", &I) << " by its neutral element removed";
+  });
   I.replaceAllUsesWith(LHS);
   return true;
 }
 
-bool LocalOpts::StrengthReductionOpt(Instruction &I) {
+bool LocalOpts::StrengthReductionOpt(Instruction &I, OptimizationRemarkEmitter *ORE) {
   // opcode -> shift operation
-  const std::unordered_map<unsigned, Instruction::BinaryOps> operations = {
+  static const std::unordered_map<unsigned, Instruction::BinaryOps> operations = {
     {Instruction::Mul, Instruction::Shl},
     {Instruction::UDiv, Instruction::LShr},
     {Instruction::SDiv, Instruction::AShr}
@@ -86,9 +100,10 @@ bool LocalOpts::StrengthReductionOpt(Instruction &I) {
   Value *LHS = I.getOperand(0);
   Value *RHS = I.getOperand(1);
 
-  auto isConstPowOf2 = [](Value *op) {
+  // A signed division by the sign bit is not a division by a power of 2
+  auto isConstPowOf2 = [opCode](Value *op) {
     if (auto *CI = dyn_cast<ConstantInt>(op)) 
-      return CI->getValue().isPowerOf2();
+      return CI->getValue().isPowerOf2() && (opCode != Instruction::SDiv || !CI->isNegative());
     return false;
   };
 
@@ -98,16 +113,36 @@ bool LocalOpts::StrengthReductionOpt(Instruction &I) {
 
   auto *CI = dyn_cast<ConstantInt>(RHS); 
   unsigned ShiftValue = CI->getValue().logBase2();
+
+  // sdiv rounds toward zero and ashr toward -inf: unless the division is
+  // exact, a negative x is biased by 2^n - 1 first, i.e.
+  // x / 2^n → (x + ((x >> (bits - 1)) >>> (bits - n))) >> n
+  SmallVector<Instruction*, 3> biasInstrs;
+  if (opCode == Instruction::SDiv && ShiftValue > 0 && !I.isExact()) {
+    unsigned bits = CI->getBitWidth();
+    auto *Sign = BinaryOperator::Create(Instruction::AShr, LHS, ConstantInt::get(CI->getType(), bits - 1));
+    auto *Bias = BinaryOperator::Create(Instruction::LShr, Sign, ConstantInt::get(CI->getType(), bits - ShiftValue));
+    auto *Biased = BinaryOperator::Create(Instruction::Add, LHS, Bias);
+    biasInstrs = {Sign, Bias, Biased};
+    LHS = Biased;
+  }
   auto *ShiftInstr = BinaryOperator::Create(ShiftOp, LHS, ConstantInt::get(CI->getType(), ShiftValue));
 
-  errs() << "Strength Reduction: " << I << "\n";
+  ++NumStrengthReductions;
+  if (ORE) ORE->emit([&] {
+    return OptimizationRemark(DEBUG_TYPE, "StrengthReduction", &I)
+           << ore::NV("Inst", &I) << " by " << ore::NV("Constant", CI)
+           << " turned into a shift by " << ore::NV("Shift", ShiftValue);
+  });
+  for (Instruction *BiasInstr : biasInstrs)
+    BiasInstr->insertBefore(&I);
   ShiftInstr->insertBefore(&I);
   I.replaceAllUsesWith(ShiftInstr);
   return true;
 }
 
 // Handles advSR x * 15 → (x << 4) - x.
-bool LocalOpts::AdvancedMulSROpt(Instruction &I) {
+bool LocalOpts::AdvancedMulSROpt(Instruction &I, OptimizationRemarkEmitter *ORE) {
   auto opCode = I.getOpcode();
   if (opCode != Instruction::Mul) return false; 
 
@@ -138,18 +173,23 @@ bool LocalOpts::AdvancedMulSROpt(Instruction &I) {
   if (!isValid) return false;
 
   auto *ShiftInstr = BinaryOperator::Create(Instruction::Shl, LHS, ConstantInt::get(CI->getType(), ShiftValue));
-  auto *AdjustInstr = BinaryOperator::Create(adjustOp, ShiftInstr, ConstantInt::get(CI->getType(), 1));
-
-  errs() << "Adv Strength Reduction: " << I << "\n";
+  auto *AdjustInstr = BinaryOperator::Create(adjustOp, ShiftInstr, LHS);
+
+  ++NumAdvancedStrengthReductions;
+  if (ORE) ORE->emit([&] {
+    return OptimizationRemark(DEBUG_TYPE, "AdvancedStrengthReduction", &I)
+           << "mul by " << ore::NV("Constant", CI) << " turned into a shift by "
+           << ore::NV("Shift", ShiftValue) << " and an adjusting " << ore::NV("Adjust", Instruction::getOpcodeName(adjustOp));
+  });
   ShiftInstr->insertBefore(&I);
   AdjustInstr->insertAfter(ShiftInstr);
   I.replaceAllUsesWith(AdjustInstr);
   return true;
 }
 
-bool LocalOpts::MultiInstructionOpt(Instruction &I) {
+bool LocalOpts::MultiInstructionOpt(Instruction &I, OptimizationRemarkEmitter *ORE) {
   // opcode -> opposite operation
-  const std::unordered_map<unsigned, Instruction::BinaryOps> operations = {
+  static const std::unordered_map<unsigned, Instruction::BinaryOps> operations = {
     {Instruction::Add, Instruction::Sub},
     {Instruction::Sub, Instruction::Add},
   };
@@ -181,13 +221,17 @@ bool LocalOpts::MultiInstructionOpt(Instruction &I) {
 
   if (opCode2 != InverseOp || operandsPair2.second != operandsPair1.second) return false;
 
-  errs() << "Multi Instruction: " << I << "\n";
+  ++NumMultiInstructions;
+  if (ORE) ORE->emit([&] {
+    return OptimizationRemark(DEBUG_TYPE, "MultiInstruction", &I)
+           << ore::NV("Inst", &I) << " folded with the opposite " << ore::NV("Inverse", UsedInstr);
+  });
   I.replaceAllUsesWith(operandsPair2.first);
   return true;
 }
 
 // Subtraction-based multi-instr patterns, e.g., a = 1 - b, c = 1 - a → c = b.
-bool LocalOpts::SubMultiInstrOpt(Instruction &I){
+bool LocalOpts::SubMultiInstrOpt(Instruction &I, OptimizationRemarkEmitter *ORE){
   auto opCode = I.getOpcode();
   if (opCode != Instruction::Sub) return false; 
 
@@ -209,17 +253,25 @@ bool LocalOpts::SubMultiInstrOpt(Instruction &I){
   if (!(CI2 = dyn_cast<ConstantInt>(LHS2))) return false;
   if (CI != CI2) return false;
 
-  errs() << "Multi Instruction Sub: " << I << "\n";
+  ++NumMultiInstructions;
+  if (ORE) ORE->emit([&] {
+    return OptimizationRemark(DEBUG_TYPE, "MultiInstruction", &I)
+           << ore::NV("Inst", &I) << " from the same constant folded with " << ore::NV("Inverse", UsedInstr);
+  });
   I.replaceAllUsesWith(RHS2);
   return true;
 }
 
-PassPluginLibraryInfo getLocalOptPluginInfo() {
+PassPluginLibraryInfo getLocalOptsPluginInfo() {
   return {
     LLVM_PLUGIN_API_VERSION,
     "LocalOpts",
     "v1.0",
     [](PassBuilder &PB) {
+      PB.registerAnalysisRegistrationCallback(
+        [](FunctionAnalysisManager &FAM) {
+          registerDFAAnalyses(FAM);
+        });
       PB.registerPipelineParsingCallback(
         [](StringRef Name, FunctionPassManager &FPM,
            ArrayRef<PassBuilder::PipelineElement>) {
@@ -227,13 +279,20 @@ PassPluginLibraryInfo getLocalOptPluginInfo() {
             FPM.addPass(LocalOpts());
             return true;
           }
+          if (Name == "SCCP-opt") {
+            FPM.addPass(SCCPOpt());
+            return true;
+          }
           return false;
         });
     }
   };
 }
 
+// The unified plugin provides its own entry point
+#ifndef UNIFIED_PLUGIN
 extern "C" LLVM_ATTRIBUTE_WEAK ::llvm::PassPluginLibraryInfo
 llvmGetPassPluginInfo() {
-    return getLocalOptPluginInfo();
-}
\ No newline at end of file
+    return getLocalOptsPluginInfo();
+}
+#endif
\ No newline at end of file
@@ -12,19 +12,26 @@
 #include "llvm/Passes/PassPlugin.h"
 #include "llvm/IR/InstrTypes.h"
 #include "llvm/IR/Module.h"
+#include "llvm/Analysis/OptimizationRemarkEmitter.h"
+
+#include "DFA.h"
 
 namespace llvm {
 
 class LocalOpts : public PassInfoMixin<LocalOpts> {
     public:
         PreservedAnalyses run(Function &F, FunctionAnalysisManager &FAM);
-        static bool runOnBasicBlock(BasicBlock &B);
-        static bool AlgebraicIdentityOpt(Instruction &I);
-        static bool StrengthReductionOpt(Instruction &I);
-        static bool AdvancedMulSROpt(Instruction &I);
-        static bool MultiInstructionOpt(Instruction &I);
-        static bool SubMultiInstrOpt(Instruction &I);
+        // The rewrites report a remark to ORE, when given
+        static bool runOnBasicBlock(BasicBlock &B, OptimizationRemarkEmitter *ORE = nullptr);
+        static bool AlgebraicIdentityOpt(Instruction &I, OptimizationRemarkEmitter *ORE = nullptr);
+        static bool StrengthReductionOpt(Instruction &I, OptimizationRemarkEmitter *ORE = nullptr);
+        static bool AdvancedMulSROpt(Instruction &I, OptimizationRemarkEmitter *ORE = nullptr);
+        static bool MultiInstructionOpt(Instruction &I, OptimizationRemarkEmitter *ORE = nullptr);
+        static bool SubMultiInstrOpt(Instruction &I, OptimizationRemarkEmitter *ORE = nullptr);
     };
 }
 
+// Pipeline names of this plugin, also registered by the unified plugin
+llvm::PassPluginLibraryInfo getLocalOptsPluginInfo();
+
 #endif
\ No newline at end of file
@@ -0,0 +1,276 @@
+#include "SCCP.h"
+#include "LocalOpts.h"
+
+#include "llvm/ADT/Statistic.h"
+using namespace llvm;
+
+#define DEBUG_TYPE "SCCP-opt"
+
+STATISTIC(NumConstants, "Instructions replaced by a constant");
+STATISTIC(NumFoldedBranches, "Branches on a constant condition folded");
+
+bool LatticeValue::mergeIn(const LatticeValue &Other) {
+  if (Other.state == Undefined || state == Overdefined) return false;
+
+  if (Other.state == Overdefined || (state == Constant && constant != Other.constant)) {
+    state = Overdefined;
+    constant = nullptr;
+    return true;
+  }
+
+  if (state == Constant) return false;
+
+  state = Constant;
+  constant = Other.constant;
+  return true;
+}
+
+namespace {
+
+// Sparse conditional constant propagation (Wegman-Zadeck): values start at
+// undefined and only blocks reached through executable edges are evaluated.
+class ConstantPropagationSolver {
+  public:
+    explicit ConstantPropagationSolver(Function &F) : DL(F.getParent()->getDataLayout()) {}
+
+    void solve(Function &F);
+    LatticeValue getValue(Value *V) const;
+    bool isExecutable(BasicBlock *BB) const { return Executable.contains(BB); }
+    bool isEdgeExecutable(BasicBlock *From, BasicBlock *To) const { return ExecutableEdges.contains({From, To}); }
+
+  private:
+    void markEdgeExecutable(BasicBlock *From, BasicBlock *To);
+    void update(Instruction &I, const LatticeValue &New);
+    void visit(Instruction &I);
+    void visitPHI(PHINode &PN);
+    void getFeasibleSuccessors(Instruction &TI, SmallVectorImpl<BasicBlock*> &Succs);
+
+    const DataLayout &DL;
+    DenseMap<Value*, LatticeValue> Values;
+    SmallPtrSet<BasicBlock*, 16> Executable;
+    DenseSet<std::pair<BasicBlock*, BasicBlock*>> ExecutableEdges;
+    SmallVector<std::pair<BasicBlock*, BasicBlock*>> CFGWorklist;
+    SmallVector<Instruction*> SSAWorklist;
+};
+
+}
+
+LatticeValue ConstantPropagationSolver::getValue(Value *V) const {
+  LatticeValue LV;
+
+  // undef may take a different value at every use
+  if (auto *C = dyn_cast<Constant>(V); C && !isa<UndefValue>(C)) {
+    LV.state = LatticeValue::Constant;
+    LV.constant = C;
+    return LV;
+  }
+
+  if (!isa<Instruction>(V)) {
+    LV.state = LatticeValue::Overdefined;
+    return LV;
+  }
+
+  auto it = Values.find(V);
+  return it == Values.end() ? LV : it->second;
+}
+
+void ConstantPropagationSolver::solve(Function &F) {
+  markEdgeExecutable(nullptr, &F.getEntryBlock());
+
+  while (!CFGWorklist.empty() || !SSAWorklist.empty()) {
+    while (!SSAWorklist.empty()) {
+      Instruction *I = SSAWorklist.pop_back_val();
+      if (isExecutable(I->getParent())) visit(*I);
+    }
+
+    while (!CFGWorklist.empty()) {
+      auto [From, To] = CFGWorklist.pop_back_val();
+
+      // First time the block is reached: evaluate all of it,
+      // otherwise only the PHIs see a new incoming edge
+      if (Executable.insert(To).second) {
+        for (Instruction &I : *To) visit(I);
+      } else {
+        for (PHINode &PN : To->phis()) visitPHI(PN);
+      }
+    }
+  }
+}
+
+void ConstantPropagationSolver::markEdgeExecutable(BasicBlock *From, BasicBlock *To) {
+  if (ExecutableEdges.insert({From, To}).second)
+    CFGWorklist.push_back({From, To});
+}
+
+void ConstantPropagationSolver::update(Instruction &I, const LatticeValue &New) {
+  if (!Values[&I].mergeIn(New)) return;
+
+  for (User *user : I.users())
+    if (auto *userInstr = dyn_cast<Instruction>(user))
+      SSAWorklist.push_back(userInstr);
+}
+
+void ConstantPropagationSolver::visitPHI(PHINode &PN) {
+  LatticeValue result;
+  for (unsigned i = 0, e = PN.getNumIncomingValues(); i < e; ++i)
+    if (ExecutableEdges.contains({PN.getIncomingBlock(i), PN.getParent()}))
+      result.mergeIn(getValue(PN.getIncomingValue(i)));
+
+  update(PN, result);
+}
+
+void ConstantPropagationSolver::visit(Instruction &I) {
+  if (auto *PN = dyn_cast<PHINode>(&I)) return visitPHI(*PN);
+
+  if (I.isTerminator()) {
+    SmallVector<BasicBlock*, 2> succs;
+    getFeasibleSuccessors(I, succs);
+    for (BasicBlock *succ : succs)
+      markEdgeExecutable(I.getParent(), succ);
+    return;
+  }
+
+  if (I.getType()->isVoidTy()) return;
+
+  LatticeValue result;
+  result.state = LatticeValue::Overdefined;
+
+  // select on a known condition takes the value of the chosen operand
+  if (auto *SI = dyn_cast<SelectInst>(&I)) {
+    LatticeValue cond = getValue(SI->getCondition());
+    if (cond.state == LatticeValue::Undefined) return;
+
+    if (auto *CI = dyn_cast_or_null<ConstantInt>(cond.constant)) {
+      result = getValue(CI->isOne() ? SI->getTrueValue() : SI->getFalseValue());
+    } else {
+      result = getValue(SI->getTrueValue());
+      result.mergeIn(getValue(SI->getFalseValue()));
+    }
+    return update(I, result);
+  }
+
+  if (!isa<BinaryOperator>(I) && !isa<CastInst>(I) && !isa<CmpInst>(I))
+    return update(I, result);
+
+  SmallVector<Constant*, 2> ops;
+  for (Value *op : I.operands()) {
+    LatticeValue opValue = getValue(op);
+    if (opValue.isOverdefined()) return update(I, result);
+    if (!opValue.isConstant()) return; // wait for the operand
+    ops.push_back(opValue.constant);
+  }
+
+  Constant *C = nullptr;
+  if (auto *cmp = dyn_cast<CmpInst>(&I))
+    C = ConstantFoldCompareInstOperands(cmp->getPredicate(), ops[0], ops[1], DL);
+  else
+    C = ConstantFoldInstOperands(&I, ops, DL);
+
+  if (C && !isa<UndefValue>(C)) {
+    result.state = LatticeValue::Constant;
+    result.constant = C;
+  }
+
+  update(I, result);
+}
+
+void ConstantPropagationSolver::getFeasibleSuccessors(Instruction &TI, SmallVectorImpl<BasicBlock*> &Succs) {
+  Value *cond = nullptr;
+  if (auto *BI = dyn_cast<BranchInst>(&TI); BI && BI->isConditional())
+    cond = BI->getCondition();
+  else if (auto *SI = dyn_cast<SwitchInst>(&TI))
+    cond = SI->getCondition();
+
+  if (!cond) {
+    append_range(Succs, successors(&TI));
+    return;
+  }
+
+  LatticeValue condValue = getValue(cond);
+  if (condValue.state == LatticeValue::Undefined) return;
+
+  auto *CI = dyn_cast_or_null<ConstantInt>(condValue.constant);
+  if (!CI) {
+    append_range(Succs, successors(&TI));
+    return;
+  }
+
+  if (auto *BI = dyn_cast<BranchInst>(&TI))
+    Succs.push_back(BI->getSuccessor(CI->isZero()));
+  else
+    Succs.push_back(cast<SwitchInst>(&TI)->findCaseValue(CI)->getCaseSuccessor());
+}
+
+PreservedAnalyses SCCPOpt::run(Function &F, FunctionAnalysisManager &FAM) {
+  auto &ORE = FAM.getResult<OptimizationRemarkEmitterAnalysis>(F);
+
+  ConstantPropagationSolver solver(F);
+  {
+    TimeTraceScope scope("SCCPOpt solve", F.getName());
+    solver.solve(F);
+  }
+
+  bool changed = false;
+  SmallVector<WeakVH> touched;
+
+  for (BasicBlock &BB : F) {
+    if (!solver.isExecutable(&BB)) continue;
+
+    for (Instruction &I : make_early_inc_range(BB)) {
+      if (I.isTerminator() || I.getType()->isVoidTy()) continue;
+
+      LatticeValue LV = solver.getValue(&I);
+      if (!LV.isConstant()) continue;
+
+      // Users now have a constant operand for the local rewrites
+      for (User *user : I.users())
+        touched.push_back(user);
+
+      ++NumConstants;
+      ORE.emit([&] {
+        return OptimizationRemark(DEBUG_TYPE, "Constant", &I)
+               << ore::NV("Inst", &I) << " replaced by the constant " << ore::NV("Constant", LV.constant);
+      });
+      I.replaceAllUsesWith(LV.constant);
+      if (isInstructionTriviallyDead(&I)) I.eraseFromParent();
+      changed = true;
+    }
+  }
+
+  // The edges the solver never took are cut once every condition is
+  // replaced: folding a terminator may simplify the PHIs of its successors
+  for (BasicBlock &BB : F) {
+    if (!solver.isExecutable(&BB)) continue;
+
+    auto isEdgeExecutable = [&](BasicBlock *Succ) { return solver.isEdgeExecutable(&BB, Succ); };
+    if (all_of(successors(&BB), isEdgeExecutable)) continue;
+
+    // Branches on a constant condition become unconditional
+    if (ConstantFoldTerminator(&BB, true)) {
+      ++NumFoldedBranches;
+      changed = true;
+      continue;
+    }
+
+    // A branch on a value the solver never defined has no executable successor
+    if (none_of(successors(&BB), isEdgeExecutable)) {
+      changeToUnreachable(BB.getTerminator());
+      changed = true;
+    }
+  }
+
+  // Blocks never reached through an executable edge, now cut off the CFG
+  changed |= removeUnreachableBlocks(F);
+
+  for (WeakVH &VH : touched) {
+    auto *I = dyn_cast_or_null<Instruction>(VH);
+    if (!I || !I->isBinaryOp()) continue;
+
+    if (LocalOpts::AlgebraicIdentityOpt(*I, &ORE) || LocalOpts::StrengthReductionOpt(*I, &ORE)) {
+      I->eraseFromParent();
+      changed = true;
+    }
+  }
+
+  return changed ? PreservedAnalyses::none() : PreservedAnalyses::all();
+}
@@ -0,0 +1,40 @@
+#ifndef SCCP_OPT_H
+#define SCCP_OPT_H
+
+#include "llvm/IR/Function.h"
+#include "llvm/IR/Instructions.h"
+#include "llvm/IR/PassManager.h"
+#include "llvm/Support/raw_ostream.h"
+#include "llvm/IR/Constants.h"
+#include "llvm/IR/InstrTypes.h"
+#include "llvm/IR/Module.h"
+
+#include "llvm/ADT/DenseSet.h"
+#include "llvm/ADT/SmallPtrSet.h"
+#include "llvm/Analysis/ConstantFolding.h"
+#include "llvm/Analysis/OptimizationRemarkEmitter.h"
+#include "llvm/Support/TimeProfiler.h"
+#include "llvm/Transforms/Utils/Local.h"
+
+namespace llvm {
+
+// Constant Propagation lattice of DFA.md: undefined > constant > overdefined
+struct LatticeValue {
+    enum State { Undefined, Constant, Overdefined };
+
+    State state = Undefined;
+    llvm::Constant *constant = nullptr;
+
+    bool isConstant() const { return state == Constant; }
+    bool isOverdefined() const { return state == Overdefined; }
+    // Meet with Other, returns true if the value moved down the lattice
+    bool mergeIn(const LatticeValue &Other);
+};
+
+class SCCPOpt : public PassInfoMixin<SCCPOpt> {
+    public:
+        PreservedAnalyses run(Function &F, FunctionAnalysisManager &FAM);
+    };
+}
+
+#endif
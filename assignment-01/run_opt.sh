@@ -6,7 +6,7 @@ LL_DIR="test/ll"
 LL_OPT_DIR="test/ll_opt"
 mkdir -p "$CPP_DIR" "$BC_DIR" "$LL_DIR" "$LL_OPT_DIR"
 
-OPT_PASS="local-opts"
+OPT_PASS=${OPT_PASS:-"local-opts"}
 
 # Get the plugin path from the environment variable
 OPT_PLUGIN=${OPT_PLUGIN_PATH:-""}
@@ -0,0 +1,21 @@
+// CONSTANT: k stays 2, the else branch is unreachable and x * k becomes x << 1
+int constLoop(int x, int n) {
+    int k = 2;
+
+    for (int i = 0; i < n; i++) {
+        if (k < 100)
+            k = k + 0;
+        else
+            k = k + 2;
+    }
+
+    return x * k;
+}
+
+// CONSTANT: a + b - 4 folds to 0, then y + 0 is an algebraic identity
+int foldToIdentity(int y) {
+    int a = 1, b = 3;
+    int z = a + b - 4;
+
+    return y + z;
+}
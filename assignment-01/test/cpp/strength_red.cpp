@@ -11,4 +11,10 @@ void test_advancedSR(int x){
 void test_NoSR(int x){
     int a = x * 29;
     int b = x / 17;
-}
\ No newline at end of file
+}
+
+// sdiv rounds toward zero: -7 / 2 is -3, but -7 >> 1 is -4
+void test_SRSignedDiv(int x){
+    int a = x / 2;
+    unsigned b = (unsigned)x / 8;
+}
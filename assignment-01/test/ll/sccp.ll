@@ -0,0 +1,61 @@
+; ModuleID = 'test/bc/sccp.bc'
+source_filename = "test/cpp/sccp.cpp"
+target datalayout = "e-m:e-p270:32:32-p271:32:32-p272:64:64-i64:64-i128:128-f80:128-n8:16:32:64-S128"
+target triple = "x86_64-pc-linux-gnu"
+
+; Function Attrs: mustprogress noinline nounwind uwtable
+define dso_local noundef i32 @_Z9constLoopii(i32 noundef %0, i32 noundef %1) #0 {
+  br label %3
+
+3:                                                ; preds = %12, %2
+  %.01 = phi i32 [ 2, %2 ], [ %.1, %12 ]
+  %.0 = phi i32 [ 0, %2 ], [ %13, %12 ]
+  %4 = icmp slt i32 %.0, %1
+  br i1 %4, label %5, label %14
+
+5:                                                ; preds = %3
+  %6 = icmp slt i32 %.01, 100
+  br i1 %6, label %7, label %9
+
+7:                                                ; preds = %5
+  %8 = add nsw i32 %.01, 0
+  br label %11
+
+9:                                                ; preds = %5
+  %10 = add nsw i32 %.01, 2
+  br label %11
+
+11:                                               ; preds = %9, %7
+  %.1 = phi i32 [ %8, %7 ], [ %10, %9 ]
+  br label %12
+
+12:                                               ; preds = %11
+  %13 = add nsw i32 %.0, 1
+  br label %3, !llvm.loop !6
+
+14:                                               ; preds = %3
+  %15 = mul nsw i32 %0, %.01
+  ret i32 %15
+}
+
+; Function Attrs: mustprogress noinline nounwind uwtable
+define dso_local noundef i32 @_Z14foldToIdentityi(i32 noundef %0) #0 {
+  %2 = add nsw i32 1, 3
+  %3 = sub nsw i32 %2, 4
+  %4 = add nsw i32 %0, %3
+  ret i32 %4
+}
+
+attributes #0 = { mustprogress noinline nounwind uwtable "frame-pointer"="all" "min-legal-vector-width"="0" "no-trapping-math"="true" "stack-protector-buffer-size"="8" "target-cpu"="x86-64" "target-features"="+cmov,+cx8,+fxsr,+mmx,+sse,+sse2,+x87" "tune-cpu"="generic" }
+
+!llvm.module.flags = !{!0, !1, !2, !3, !4}
+!llvm.ident = !{!5}
+
+!0 = !{i32 1, !"wchar_size", i32 4}
+!1 = !{i32 8, !"PIC Level", i32 2}
+!2 = !{i32 7, !"PIE Level", i32 2}
+!3 = !{i32 7, !"uwtable", i32 2}
+!4 = !{i32 7, !"frame-pointer", i32 2}
+!5 = !{!"Ubuntu clang version 19.1.7 (++20250114103320+cd708029e0b2-1~exp1~20250114103432.75)"}
+!6 = distinct !{!6, !7}
+!7 = !{!"llvm.loop.mustprogress"}
@@ -24,6 +24,13 @@ define dso_local void @_Z9test_NoSRi(i32 noundef %0) #0 {
   ret void
 }
 
+; Function Attrs: mustprogress noinline nounwind uwtable
+define dso_local void @_Z16test_SRSignedDivi(i32 noundef %0) #0 {
+  %2 = sdiv i32 %0, 2
+  %3 = udiv i32 %0, 8
+  ret void
+}
+
 attributes #0 = { mustprogress noinline nounwind uwtable "frame-pointer"="all" "min-legal-vector-width"="0" "no-trapping-math"="true" "stack-protector-buffer-size"="8" "target-cpu"="x86-64" "target-features"="+cmov,+cx8,+fxsr,+mmx,+sse,+sse2,+x87" "tune-cpu"="generic" }
 
 !llvm.module.flags = !{!0, !1, !2, !3, !4}
@@ -6,16 +6,19 @@ target triple = "x86_64-pc-linux-gnu"
 ; Function Attrs: mustprogress noinline nounwind uwtable
 define dso_local void @_Z13test_SRPowOf2i(i32 noundef %0) #0 {
   %2 = shl i32 %0, 3
-  %3 = ashr i32 %0, 2
+  %3 = ashr i32 %0, 31
+  %4 = lshr i32 %3, 30
+  %5 = add i32 %0, %4
+  %6 = ashr i32 %5, 2
   ret void
 }
 
 ; Function Attrs: mustprogress noinline nounwind uwtable
 define dso_local void @_Z15test_advancedSRi(i32 noundef %0) #0 {
   %2 = shl i32 %0, 4
-  %3 = add i32 %2, 1
+  %3 = add i32 %2, %0
   %4 = shl i32 %0, 4
-  %5 = sub i32 %4, 1
+  %5 = sub i32 %4, %0
   ret void
 }
 
@@ -26,6 +29,16 @@ define dso_local void @_Z9test_NoSRi(i32 noundef %0) #0 {
   ret void
 }
 
+; Function Attrs: mustprogress noinline nounwind uwtable
+define dso_local void @_Z16test_SRSignedDivi(i32 noundef %0) #0 {
+  %2 = ashr i32 %0, 31
+  %3 = lshr i32 %2, 31
+  %4 = add i32 %0, %3
+  %5 = ashr i32 %4, 1
+  %6 = lshr i32 %0, 3
+  ret void
+}
+
 attributes #0 = { mustprogress noinline nounwind uwtable "frame-pointer"="all" "min-legal-vector-width"="0" "no-trapping-math"="true" "stack-protector-buffer-size"="8" "target-cpu"="x86-64" "target-features"="+cmov,+cx8,+fxsr,+mmx,+sse,+sse2,+x87" "tune-cpu"="generic" }
 
 !llvm.module.flags = !{!0, !1, !2, !3, !4}
@@ -8,7 +8,10 @@ define dso_local void @_Z9test_optsi(i32 noundef %0) #0 {
   %2 = shl i32 %0, 5
   %3 = add nsw i32 %0, 5
   %4 = sdiv i32 %0, %2
-  %5 = ashr i32 %4, 2
+  %5 = ashr i32 %4, 31
+  %6 = lshr i32 %5, 30
+  %7 = add i32 %4, %6
+  %8 = ashr i32 %7, 2
   ret void
 }
 
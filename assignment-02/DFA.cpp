@@ -0,0 +1,267 @@
+#include "DFA.h"
+using namespace llvm;
+
+ExpressionUniverse::ExpressionUniverse(Function &F) {
+  for (BasicBlock &BB : F) {
+    for (Instruction &I : BB) {
+      if (!isExpression(I) || getIndex(I) >= 0) continue;
+
+      unsigned Idx = Exprs.size();
+      Exprs.push_back(&I);
+      Indices[getKey(I, false)] = Idx;
+
+      for (Value *op : I.operands())
+        if (isa<Instruction>(op) || isa<Argument>(op))
+          OperandUsers[op].push_back(Idx);
+    }
+  }
+}
+
+bool ExpressionUniverse::isExpression(const Instruction &I) {
+  return isa<BinaryOperator>(I) || isa<CmpInst>(I);
+}
+
+ExpressionUniverse::ExprKey ExpressionUniverse::getKey(const Instruction &I, bool Swapped) {
+  auto *cmp = dyn_cast<CmpInst>(&I);
+  unsigned predicate = cmp ? cmp->getPredicate() : 0;
+  Value *LHS = I.getOperand(Swapped);
+  Value *RHS = I.getOperand(!Swapped);
+
+  return {I.getOpcode(), predicate, I.getType(), LHS, RHS};
+}
+
+int ExpressionUniverse::getIndex(const Instruction &I) const {
+  if (!isExpression(I)) return -1;
+
+  auto it = Indices.find(getKey(I, false));
+  // a + b and b + a are the same expression
+  if (it == Indices.end() && I.isCommutative())
+    it = Indices.find(getKey(I, true));
+
+  return it == Indices.end() ? -1 : it->second;
+}
+
+ArrayRef<unsigned> ExpressionUniverse::getUsersOf(const Value *V) const {
+  auto it = OperandUsers.find(V);
+  if (it == OperandUsers.end()) return {};
+  return it->second;
+}
+
+void ExpressionUniverse::print(raw_ostream &OS, const BitVector &Set) const {
+  OS << "{";
+  for (unsigned Idx : Set.set_bits()) {
+    Instruction *I = Exprs[Idx];
+    OS << " (" << I->getOpcodeName();
+    if (auto *cmp = dyn_cast<CmpInst>(I))
+      OS << " " << CmpInst::getPredicateName(cmp->getPredicate());
+    for (Value *op : I->operands()) {
+      OS << " ";
+      op->printAsOperand(OS, false);
+    }
+    OS << ")";
+  }
+  OS << " }";
+}
+
+bool ExpressionDataflowInfo::containsIn(const Instruction &I, const BasicBlock *BB) const {
+  int Idx = Exprs.getIndex(I);
+  return Idx >= 0 && getIn(BB).test(Idx);
+}
+
+bool ExpressionDataflowInfo::containsOut(const Instruction &I, const BasicBlock *BB) const {
+  int Idx = Exprs.getIndex(I);
+  return Idx >= 0 && getOut(BB).test(Idx);
+}
+
+void ExpressionDataflowInfo::print(raw_ostream &OS, Function &F) const {
+  for (BasicBlock &BB : F) {
+    BB.printAsOperand(OS, false);
+    OS << "\n  In:  ";
+    Exprs.print(OS, getIn(&BB));
+    OS << "\n  Out: ";
+    Exprs.print(OS, getOut(&BB));
+    OS << "\n";
+  }
+}
+
+bool LivenessInfo::isLiveIn(const Value *V, const BasicBlock *BB) const {
+  auto it = Indices.find(V);
+  return it != Indices.end() && getIn(BB).test(it->second);
+}
+
+bool LivenessInfo::isLiveOut(const Value *V, const BasicBlock *BB) const {
+  auto it = Indices.find(V);
+  return it != Indices.end() && getOut(BB).test(it->second);
+}
+
+void LivenessInfo::print(raw_ostream &OS, Function &F) const {
+  auto printSet = [&](const BitVector &Set) {
+    OS << "{";
+    for (unsigned Idx : Set.set_bits()) {
+      OS << " ";
+      Values[Idx]->printAsOperand(OS, false);
+    }
+    OS << " }";
+  };
+
+  for (BasicBlock &BB : F) {
+    BB.printAsOperand(OS, false);
+    OS << "\n  In:  ";
+    printSet(getIn(&BB));
+    OS << "\n  Out: ";
+    printSet(getOut(&BB));
+    OS << "\n";
+  }
+}
+
+namespace {
+
+// Gen[b]: expressions evaluated in b before any of their operands is defined
+// in b. Kill[b]: expressions with an operand defined in b.
+struct VeryBusyExpressionsProblem : GenKillProblem {
+  static constexpr DataflowDirection Direction = DataflowDirection::Backward;
+  const ExpressionUniverse &Exprs;
+
+  VeryBusyExpressionsProblem(Function &F, const ExpressionUniverse &Exprs) : Exprs(Exprs) {
+    for (BasicBlock &BB : F) {
+      auto [Gen, Kill] = getGenKill(BB, size());
+
+      for (Instruction &I : BB) {
+        int Idx = Exprs.getIndex(I);
+        if (Idx >= 0 && !Kill.test(Idx)) Gen.set(Idx);
+
+        for (unsigned user : Exprs.getUsersOf(&I))
+          Kill.set(user);
+      }
+    }
+  }
+
+  unsigned size() const { return Exprs.size(); }
+  BitVector boundary() const { return BitVector(size()); }
+  BitVector initial() const { return BitVector(size(), true); }
+  void meet(BitVector &Acc, const BitVector &V) const { Acc &= V; }
+};
+
+// Gen[b]: expressions evaluated in b. Kill[b]: expressions with an operand
+// defined in b and not evaluated afterwards.
+struct AvailableExpressionsProblem : GenKillProblem {
+  static constexpr DataflowDirection Direction = DataflowDirection::Forward;
+  const ExpressionUniverse &Exprs;
+
+  AvailableExpressionsProblem(Function &F, const ExpressionUniverse &Exprs) : Exprs(Exprs) {
+    for (BasicBlock &BB : F) {
+      auto [Gen, Kill] = getGenKill(BB, size());
+
+      for (Instruction &I : BB) {
+        int Idx = Exprs.getIndex(I);
+        if (Idx >= 0) Gen.set(Idx);
+
+        for (unsigned user : Exprs.getUsersOf(&I)) {
+          Kill.set(user);
+          Gen.reset(user);
+        }
+      }
+    }
+  }
+
+  unsigned size() const { return Exprs.size(); }
+  BitVector boundary() const { return BitVector(size()); }
+  BitVector initial() const { return BitVector(size(), true); }
+  void meet(BitVector &Acc, const BitVector &V) const { Acc &= V; }
+};
+
+// Gen[b]: values used in b before their definition (phi operands excluded).
+// Kill[b]: values defined in b. Phi operands are added on the incoming edge.
+struct LivenessProblem : GenKillProblem {
+  static constexpr DataflowDirection Direction = DataflowDirection::Backward;
+  const DenseMap<const Value*, unsigned> &Indices;
+
+  LivenessProblem(Function &F, const DenseMap<const Value*, unsigned> &Indices) : Indices(Indices) {
+    for (BasicBlock &BB : F) {
+      auto [Gen, Kill] = getGenKill(BB, size());
+
+      for (Instruction &I : BB) {
+        if (!isa<PHINode>(I)) {
+          for (Value *op : I.operands()) {
+            auto it = Indices.find(op);
+            if (it != Indices.end() && !Kill.test(it->second))
+              Gen.set(it->second);
+          }
+        }
+
+        auto it = Indices.find(&I);
+        if (it != Indices.end()) Kill.set(it->second);
+      }
+    }
+  }
+
+  void edge(const BasicBlock &From, const BasicBlock &To, BitVector &V) const {
+    for (const PHINode &PN : To.phis()) {
+      auto it = Indices.find(PN.getIncomingValueForBlock(&From));
+      if (it != Indices.end()) V.set(it->second);
+    }
+  }
+
+  unsigned size() const { return Indices.size(); }
+  BitVector boundary() const { return BitVector(size()); }
+  BitVector initial() const { return BitVector(size()); }
+  void meet(BitVector &Acc, const BitVector &V) const { Acc |= V; }
+};
+
+}
+
+AnalysisKey VeryBusyExpressionsAnalysis::Key;
+AnalysisKey AvailableExpressionsAnalysis::Key;
+AnalysisKey LivenessAnalysis::Key;
+
+ExpressionDataflowInfo VeryBusyExpressionsAnalysis::run(Function &F, FunctionAnalysisManager &FAM) {
+  ExpressionUniverse Exprs(F);
+  DataflowResult Result = solveDataflow(F, VeryBusyExpressionsProblem(F, Exprs));
+  return ExpressionDataflowInfo(std::move(Exprs), std::move(Result));
+}
+
+ExpressionDataflowInfo AvailableExpressionsAnalysis::run(Function &F, FunctionAnalysisManager &FAM) {
+  ExpressionUniverse Exprs(F);
+  DataflowResult Result = solveDataflow(F, AvailableExpressionsProblem(F, Exprs));
+  return ExpressionDataflowInfo(std::move(Exprs), std::move(Result));
+}
+
+LivenessInfo LivenessAnalysis::run(Function &F, FunctionAnalysisManager &FAM) {
+  SmallVector<Value*> Values;
+  DenseMap<const Value*, unsigned> Indices;
+
+  for (Argument &A : F.args()) {
+    Indices[&A] = Values.size();
+    Values.push_back(&A);
+  }
+
+  for (Instruction &I : instructions(F)) {
+    if (I.getType()->isVoidTy()) continue;
+    Indices[&I] = Values.size();
+    Values.push_back(&I);
+  }
+
+  DataflowResult Result = solveDataflow(F, LivenessProblem(F, Indices));
+  return LivenessInfo(std::move(Values), std::move(Indices), std::move(Result));
+}
+
+PreservedAnalyses DFAPrinter::run(Function &F, FunctionAnalysisManager &FAM) {
+  OS << "\nDataflow analyses for function: " << F.getName() << "\n";
+
+  OS << "\n=== Very Busy Expressions ===\n";
+  FAM.getResult<VeryBusyExpressionsAnalysis>(F).print(OS, F);
+
+  OS << "\n=== Available Expressions ===\n";
+  FAM.getResult<AvailableExpressionsAnalysis>(F).print(OS, F);
+
+  OS << "\n=== Liveness ===\n";
+  FAM.getResult<LivenessAnalysis>(F).print(OS, F);
+
+  return PreservedAnalyses::all();
+}
+
+void llvm::registerDFAAnalyses(FunctionAnalysisManager &FAM) {
+  FAM.registerPass([] { return VeryBusyExpressionsAnalysis(); });
+  FAM.registerPass([] { return AvailableExpressionsAnalysis(); });
+  FAM.registerPass([] { return LivenessAnalysis(); });
+}
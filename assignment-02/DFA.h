@@ -0,0 +1,126 @@
+#ifndef DFA_H
+#define DFA_H
+
+#include "llvm/IR/Function.h"
+#include "llvm/IR/Instructions.h"
+#include "llvm/IR/PassManager.h"
+#include "llvm/Support/raw_ostream.h"
+#include "llvm/IR/InstrTypes.h"
+#include "llvm/IR/InstIterator.h"
+#include "llvm/Passes/PassPlugin.h"
+
+#include "Dataflow.h"
+
+#include <tuple>
+
+namespace llvm {
+
+// Binary operators and compares, identified by opcode, type and operands:
+// two instructions computing b - a in different blocks are the same expression.
+class ExpressionUniverse {
+    public:
+        explicit ExpressionUniverse(Function &F);
+        static bool isExpression(const Instruction &I);
+
+        // Index of the expression computed by I, or -1
+        int getIndex(const Instruction &I) const;
+        unsigned size() const { return Exprs.size(); }
+        // First instruction computing the expression
+        Instruction *getExpression(unsigned Idx) const { return Exprs[Idx]; }
+        // Expressions having V as an operand
+        ArrayRef<unsigned> getUsersOf(const Value *V) const;
+
+        void print(raw_ostream &OS, const BitVector &Set) const;
+
+    private:
+        using ExprKey = std::tuple<unsigned, unsigned, Type*, Value*, Value*>;
+        static ExprKey getKey(const Instruction &I, bool Swapped);
+
+        SmallVector<Instruction*> Exprs;
+        DenseMap<ExprKey, unsigned> Indices;
+        DenseMap<const Value*, SmallVector<unsigned, 2>> OperandUsers;
+};
+
+// Result shared by Very Busy Expressions and Available Expressions
+class ExpressionDataflowInfo {
+    public:
+        ExpressionDataflowInfo(ExpressionUniverse Exprs, DataflowResult Result)
+            : Exprs(std::move(Exprs)), Result(std::move(Result)) {}
+
+        const ExpressionUniverse &getExpressions() const { return Exprs; }
+        const BitVector &getIn(const BasicBlock *BB) const { return Result.getIn(BB); }
+        const BitVector &getOut(const BasicBlock *BB) const { return Result.getOut(BB); }
+        bool containsIn(const Instruction &I, const BasicBlock *BB) const;
+        bool containsOut(const Instruction &I, const BasicBlock *BB) const;
+
+        void print(raw_ostream &OS, Function &F) const;
+
+    private:
+        ExpressionUniverse Exprs;
+        DataflowResult Result;
+};
+
+// Arguments and instructions live at block boundaries (SSA: phi operands are
+// live out of the incoming block only).
+class LivenessInfo {
+    public:
+        LivenessInfo(SmallVector<Value*> Values, DenseMap<const Value*, unsigned> Indices, DataflowResult Result)
+            : Values(std::move(Values)), Indices(std::move(Indices)), Result(std::move(Result)) {}
+
+        const BitVector &getIn(const BasicBlock *BB) const { return Result.getIn(BB); }
+        const BitVector &getOut(const BasicBlock *BB) const { return Result.getOut(BB); }
+        bool isLiveIn(const Value *V, const BasicBlock *BB) const;
+        bool isLiveOut(const Value *V, const BasicBlock *BB) const;
+        Value *getValue(unsigned Idx) const { return Values[Idx]; }
+
+        void print(raw_ostream &OS, Function &F) const;
+
+    private:
+        SmallVector<Value*> Values;
+        DenseMap<const Value*, unsigned> Indices;
+        DataflowResult Result;
+};
+
+// Backward, meet = intersection, Out[exit] = {}, interior = U
+class VeryBusyExpressionsAnalysis : public AnalysisInfoMixin<VeryBusyExpressionsAnalysis> {
+        friend AnalysisInfoMixin<VeryBusyExpressionsAnalysis>;
+        static AnalysisKey Key;
+    public:
+        using Result = ExpressionDataflowInfo;
+        Result run(Function &F, FunctionAnalysisManager &FAM);
+    };
+
+// Forward, meet = intersection, In[entry] = {}, interior = U
+class AvailableExpressionsAnalysis : public AnalysisInfoMixin<AvailableExpressionsAnalysis> {
+        friend AnalysisInfoMixin<AvailableExpressionsAnalysis>;
+        static AnalysisKey Key;
+    public:
+        using Result = ExpressionDataflowInfo;
+        Result run(Function &F, FunctionAnalysisManager &FAM);
+    };
+
+// Backward, meet = union, Out[exit] = {}, interior = {}
+class LivenessAnalysis : public AnalysisInfoMixin<LivenessAnalysis> {
+        friend AnalysisInfoMixin<LivenessAnalysis>;
+        static AnalysisKey Key;
+    public:
+        using Result = LivenessInfo;
+        Result run(Function &F, FunctionAnalysisManager &FAM);
+    };
+
+class DFAPrinter : public PassInfoMixin<DFAPrinter> {
+    public:
+        explicit DFAPrinter(raw_ostream &OS) : OS(OS) {}
+        PreservedAnalyses run(Function &F, FunctionAnalysisManager &FAM);
+    private:
+        raw_ostream &OS;
+    };
+
+// Makes the analyses above available to the passes of a plugin
+void registerDFAAnalyses(FunctionAnalysisManager &FAM);
+}
+
+// Pipeline names of this plugin, also registered by the unified plugin
+llvm::PassPluginLibraryInfo getDFAPluginInfo();
+
+#endif
@@ -0,0 +1,40 @@
+#include "DFA.h"
+#include "VBEHoist.h"
+#include "llvm/Passes/PassBuilder.h"
+#include "llvm/Passes/PassPlugin.h"
+using namespace llvm;
+
+PassPluginLibraryInfo getDFAPluginInfo() {
+  return {
+    LLVM_PLUGIN_API_VERSION,
+    "DFA",
+    "v1.0",
+    [](PassBuilder &PB) {
+      PB.registerAnalysisRegistrationCallback(
+        [](FunctionAnalysisManager &FAM) {
+          registerDFAAnalyses(FAM);
+        });
+      PB.registerPipelineParsingCallback(
+        [](StringRef Name, FunctionPassManager &FPM,
+           ArrayRef<PassBuilder::PipelineElement>) {
+          if (Name == "print-dfa") {
+            FPM.addPass(DFAPrinter(outs()));
+            return true;
+          }
+          if (Name == "VBE-hoist") {
+            FPM.addPass(VBEHoistOpt());
+            return true;
+          }
+          return false;
+        });
+    }
+  };
+}
+
+// The unified plugin provides its own entry point
+#ifndef UNIFIED_PLUGIN
+extern "C" LLVM_ATTRIBUTE_WEAK ::llvm::PassPluginLibraryInfo
+llvmGetPassPluginInfo() {
+  return getDFAPluginInfo();
+}
+#endif
@@ -0,0 +1,174 @@
+#ifndef DATAFLOW_H
+#define DATAFLOW_H
+
+#include "llvm/ADT/BitVector.h"
+#include "llvm/ADT/DenseMap.h"
+#include "llvm/ADT/PostOrderIterator.h"
+#include "llvm/ADT/SmallVector.h"
+#include "llvm/IR/CFG.h"
+#include "llvm/IR/Function.h"
+
+#include <algorithm>
+
+namespace llvm {
+
+enum class DataflowDirection { Forward, Backward };
+
+// In/Out sets computed for every block reachable from the entry. The other
+// blocks never execute: their sets are empty.
+class DataflowResult {
+    public:
+        const BitVector &getIn(const BasicBlock *BB) const {
+            auto it = Index.find(BB);
+            return it == Index.end() ? Unreached : In[it->second];
+        }
+
+        const BitVector &getOut(const BasicBlock *BB) const {
+            auto it = Index.find(BB);
+            return it == Index.end() ? Unreached : Out[it->second];
+        }
+
+    private:
+        template <typename Problem>
+        friend DataflowResult solveDataflow(Function &F, const Problem &P);
+
+        DenseMap<const BasicBlock*, unsigned> Index;
+        SmallVector<BitVector, 0> In, Out;
+        BitVector Unreached;
+};
+
+// Gen/Kill transfer function: f_b(x) = Gen[b] U (x - Kill[b]).
+// Subclasses fill Gen and Kill and provide the rest of the framework:
+//   static constexpr DataflowDirection Direction;
+//   unsigned size() const;
+//   BitVector boundary() const;   // In[entry] (forward) or Out[exit] (backward)
+//   BitVector initial() const;    // value of the interior points
+//   void meet(BitVector &Acc, const BitVector &V) const;
+class GenKillProblem {
+    public:
+        void transfer(const BasicBlock &BB, const BitVector &Input, BitVector &Output) const {
+            auto it = Index.find(&BB);
+            Output = Input;
+            Output.reset(Kill[it->second]);
+            Output |= Gen[it->second];
+        }
+
+        // Adjusts the value flowing along the CFG edge From -> To before the meet
+        void edge(const BasicBlock &From, const BasicBlock &To, BitVector &V) const {}
+
+    protected:
+        std::pair<BitVector&, BitVector&> getGenKill(const BasicBlock &BB, unsigned Size) {
+            auto [it, inserted] = Index.try_emplace(&BB, Gen.size());
+            if (inserted) {
+                Gen.emplace_back(Size);
+                Kill.emplace_back(Size);
+            }
+            return {Gen[it->second], Kill[it->second]};
+        }
+
+        DenseMap<const BasicBlock*, unsigned> Index;
+        SmallVector<BitVector, 0> Gen, Kill;
+};
+
+// Iterative worklist solver. Blocks are numbered in reverse post-order
+// (forward problems) or post-order (backward problems), and the pending set is
+// a bit vector scanned from the lowest index, so every block is revisited only
+// after the blocks that flow into it.
+//
+// Backward problems start from the exits. The blocks of an infinite loop reach
+// none, so they also meet the boundary as if they could: otherwise a must
+// problem would hold vacuously there, with every expression very busy.
+template <typename Problem>
+DataflowResult solveDataflow(Function &F, const Problem &P) {
+    constexpr bool Forward = Problem::Direction == DataflowDirection::Forward;
+
+    ReversePostOrderTraversal<Function*> RPOT(&F);
+    SmallVector<BasicBlock*> Order(RPOT.begin(), RPOT.end());
+    if (!Forward) std::reverse(Order.begin(), Order.end());
+
+    DataflowResult R;
+    unsigned NumBlocks = Order.size();
+    for (unsigned i = 0; i < NumBlocks; ++i)
+        R.Index[Order[i]] = i;
+
+    R.Unreached = BitVector(P.size());
+    R.In.assign(NumBlocks, P.initial());
+    R.Out.assign(NumBlocks, P.initial());
+
+    BitVector NoExit;
+    if (!Forward) {
+        NoExit.resize(NumBlocks, true);
+        SmallVector<unsigned> Worklist;
+        for (unsigned i = 0; i < NumBlocks; ++i) {
+            if (succ_empty(Order[i])) {
+                NoExit.reset(i);
+                Worklist.push_back(i);
+            }
+        }
+
+        while (!Worklist.empty()) {
+            for (BasicBlock *Pred : predecessors(Order[Worklist.pop_back_val()])) {
+                auto it = R.Index.find(Pred);
+                if (it != R.Index.end() && NoExit.test(it->second)) {
+                    NoExit.reset(it->second);
+                    Worklist.push_back(it->second);
+                }
+            }
+        }
+    }
+
+    // Forward: In = meet(Out[preds]), Out = f(In). Backward the other way around.
+    auto &Input = Forward ? R.In : R.Out;
+    auto &Output = Forward ? R.Out : R.In;
+
+    BitVector Pending(NumBlocks, true);
+    BitVector Edge(P.size()), Result(P.size());
+
+    for (int i = Pending.find_first(); i != -1; i = Pending.find_first()) {
+        Pending.reset(i);
+        BasicBlock *BB = Order[i];
+        bool first = true;
+
+        auto meetFrom = [&](const BasicBlock &From, const BasicBlock &To, const BasicBlock *Neighbour) {
+            auto it = R.Index.find(Neighbour);
+            if (it == R.Index.end()) return;
+
+            Edge = Output[it->second];
+            P.edge(From, To, Edge);
+            if (first) Input[i] = Edge;
+            else P.meet(Input[i], Edge);
+            first = false;
+        };
+
+        if (Forward) {
+            for (BasicBlock *Pred : predecessors(BB)) meetFrom(*Pred, *BB, Pred);
+        } else {
+            for (BasicBlock *Succ : successors(BB)) meetFrom(*BB, *Succ, Succ);
+        }
+
+        if (first) Input[i] = P.boundary();
+        else if (!Forward && NoExit.test(i)) P.meet(Input[i], P.boundary());
+
+        P.transfer(*BB, Input[i], Result);
+        if (Result == Output[i]) continue;
+        Output[i] = Result;
+
+        // Reschedule the blocks reading this one
+        auto schedule = [&](const BasicBlock *Next) {
+            auto it = R.Index.find(Next);
+            if (it != R.Index.end()) Pending.set(it->second);
+        };
+
+        if (Forward) {
+            for (BasicBlock *Succ : successors(BB)) schedule(Succ);
+        } else {
+            for (BasicBlock *Pred : predecessors(BB)) schedule(Pred);
+        }
+    }
+
+    return R;
+}
+
+}
+
+#endif
@@ -0,0 +1,122 @@
+#include "VBEHoist.h"
+
+#include "llvm/ADT/Statistic.h"
+using namespace llvm;
+
+#define DEBUG_TYPE "VBE-hoist"
+
+STATISTIC(NumHoisted, "Very busy expressions hoisted to a branch point");
+STATISTIC(NumMerged, "Computations merged into a hoisted expression");
+
+PreservedAnalyses VBEHoistOpt::run(Function &F, FunctionAnalysisManager &FAM) {
+  auto &ORE = FAM.getResult<OptimizationRemarkEmitterAnalysis>(F);
+  auto &VBE = FAM.getResult<VeryBusyExpressionsAnalysis>(F);
+  auto &DT = FAM.getResult<DominatorTreeAnalysis>(F);
+  auto &LI = FAM.getResult<LoopAnalysis>(F);
+  const ExpressionUniverse &Exprs = VBE.getExpressions();
+  bool changed = false;
+
+  // Every instruction computing each expression
+  SmallVector<SmallVector<Instruction*, 2>> occurrences(Exprs.size());
+  for (Instruction &I : instructions(F)) {
+    int Idx = Exprs.getIndex(I);
+    if (Idx >= 0) occurrences[Idx].push_back(&I);
+  }
+
+  // Branch points, outermost first
+  ReversePostOrderTraversal<Function*> RPOT(&F);
+  for (BasicBlock *BB : RPOT) {
+    if (BB->getTerminator()->getNumSuccessors() < 2) continue;
+
+    for (unsigned Idx : VBE.getOut(BB).set_bits())
+      changed |= hoistExpression(BB, occurrences[Idx], DT, LI, ORE);
+  }
+
+  if (!changed) return PreservedAnalyses::all();
+
+  PreservedAnalyses PA;
+  PA.preserveSet<CFGAnalyses>();
+  return PA;
+}
+
+// Hoists an expression very busy at the end of BB into BB and merges the
+// computations dominated by it.
+bool VBEHoistOpt::hoistExpression(BasicBlock *BB, SmallVectorImpl<Instruction*> &Occurrences,
+                                  DominatorTree &DT, LoopInfo &LI, OptimizationRemarkEmitter &ORE) {
+  Instruction *term = BB->getTerminator();
+  if (Occurrences.empty() || !isSafeToSpeculativelyExecute(Occurrences.front()))
+    return false;
+
+  // Already computed on every path reaching the end of BB
+  Instruction *leader = nullptr;
+  for (Instruction *I : Occurrences) {
+    if (DT.dominates(I, term)) {
+      leader = I;
+      break;
+    }
+  }
+
+  SmallVector<Instruction*> duplicates;
+  for (Instruction *I : Occurrences) {
+    if (I == leader) continue;
+
+    if (I->getParent() != BB && DT.dominates(BB, I->getParent())) {
+      duplicates.push_back(I);
+      continue;
+    }
+
+    // A computation reachable from BB but not dominated by it would stay,
+    // so the hoisted copy would be evaluated twice on that path
+    if (!leader && isPotentiallyReachable(BB, I->getParent(), nullptr, &DT, &LI)) {
+      ORE.emit([&] {
+        return OptimizationRemarkMissed(DEBUG_TYPE, "PartiallyRedundant", I)
+               << ore::NV("Inst", I) << " not hoisted to " << ore::NV("Block", BB)
+               << ": reachable from it without being dominated by it";
+      });
+      return false;
+    }
+  }
+
+  if (duplicates.empty()) return false;
+
+  if (!leader) {
+    for (Value *op : duplicates.front()->operands()) {
+      if (auto *opInstr = dyn_cast<Instruction>(op); opInstr && !DT.dominates(opInstr, term)) {
+        ORE.emit([&] {
+          return OptimizationRemarkMissed(DEBUG_TYPE, "OperandNotAvailable", duplicates.front())
+                 << ore::NV("Inst", duplicates.front()) << " not hoisted to " << ore::NV("Block", BB)
+                 << ": an operand is computed after it";
+        });
+        return false;
+      }
+    }
+
+    leader = duplicates.front()->clone();
+    leader->insertBefore(term);
+    leader->takeName(duplicates.front());
+    Occurrences.push_back(leader);
+    ++NumHoisted;
+    ORE.emit([&] {
+      return OptimizationRemark(DEBUG_TYPE, "Hoisted", duplicates.front())
+             << ore::NV("Inst", leader) << " very busy at the end of " << ore::NV("Block", BB)
+             << " hoisted there";
+    });
+  }
+
+  SmallPtrSet<Instruction*, 4> merged;
+  for (Instruction *I : duplicates) {
+    ++NumMerged;
+    ORE.emit([&] {
+      return OptimizationRemark(DEBUG_TYPE, "Merged", I)
+             << ore::NV("Inst", I) << " merged into the copy in " << ore::NV("Block", leader->getParent());
+    });
+    // Keep only the poison-generating flags common to every merged copy
+    leader->andIRFlags(I);
+    I->replaceAllUsesWith(leader);
+    I->eraseFromParent();
+    merged.insert(I);
+  }
+
+  erase_if(Occurrences, [&](Instruction *I) { return merged.contains(I); });
+  return true;
+}
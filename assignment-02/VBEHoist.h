@@ -0,0 +1,30 @@
+#ifndef VBE_HOIST_OPT_H
+#define VBE_HOIST_OPT_H
+
+#include "llvm/IR/Function.h"
+#include "llvm/IR/Instructions.h"
+#include "llvm/IR/PassManager.h"
+#include "llvm/Support/raw_ostream.h"
+#include "llvm/IR/InstIterator.h"
+
+#include "llvm/ADT/PostOrderIterator.h"
+#include "llvm/ADT/SmallPtrSet.h"
+#include "llvm/Analysis/CFG.h"
+#include "llvm/Analysis/LoopInfo.h"
+#include "llvm/Analysis/OptimizationRemarkEmitter.h"
+#include "llvm/Analysis/ValueTracking.h"
+#include "llvm/IR/Dominators.h"
+
+#include "DFA.h"
+
+namespace llvm {
+
+class VBEHoistOpt : public PassInfoMixin<VBEHoistOpt> {
+    public:
+        PreservedAnalyses run(Function &F, FunctionAnalysisManager &FAM);
+        static bool hoistExpression(BasicBlock *BB, SmallVectorImpl<Instruction*> &Occurrences,
+                                    DominatorTree &DT, LoopInfo &LI, OptimizationRemarkEmitter &ORE);
+    };
+}
+
+#endif
@@ -0,0 +1,51 @@
+// VBE: b - a is very busy at the branch, a - b only on the first path
+int veryBusy(int a, int b) {
+    int x, y;
+
+    if (a != b) {
+        x = b - a;
+        y = a - b;
+    } else {
+        y = b - a;
+        a = 0;
+        x = a - b;
+    }
+
+    return x + y;
+}
+
+// AVAILABLE: n * 2 is available at the end of the body, but neither at the
+// header nor after the loop: the path that skips the loop never computes it
+int available(int n) {
+    int sum = 0;
+
+    for (int i = 0; i < n; i++)
+        sum += n * 2;
+
+    return sum + n * 2;
+}
+
+// LIVENESS: k is live across the loop, t only inside the body
+int liveness(int n, int k) {
+    int sum = 0;
+
+    for (int i = 0; i < n; i++) {
+        int t = i * 3;
+        sum += t;
+    }
+
+    return sum + k;
+}
+
+// VBE: the loop never exits. a - b, evaluated on every iteration, is very busy
+// at the header; a * b and a + b, each on one side of the branch, are not
+void spin(int a, int b, bool cond, int *out) {
+    for (;;) {
+        *out = a - b;
+
+        if (cond)
+            *out = a * b;
+        else
+            *out = a + b;
+    }
+}
@@ -0,0 +1,33 @@
+// HOISTED: b - a is computed on both paths, merged into the branch block
+int hoistBoth(int a, int b, bool cond) {
+    int x;
+
+    if (cond)
+        x = (b - a) * 2;
+    else
+        x = (b - a) + 7;
+
+    return x;
+}
+
+// NOT HOISTED: a * b is computed on one path only
+int onePath(int a, int b, bool cond) {
+    int x = 0;
+
+    if (cond)
+        x = a * b;
+
+    return x;
+}
+
+// NOT HOISTED: a / b may trap
+int division(int a, int b, bool cond) {
+    int x;
+
+    if (cond)
+        x = a / b + 1;
+    else
+        x = a / b - 1;
+
+    return x;
+}
@@ -0,0 +1,114 @@
+; ModuleID = 'test/bc/dfa.opt.bc'
+source_filename = "test/cpp/dfa.cpp"
+target datalayout = "e-m:e-p270:32:32-p271:32:32-p272:64:64-i64:64-i128:128-f80:128-n8:16:32:64-S128"
+target triple = "x86_64-pc-linux-gnu"
+
+; Function Attrs: mustprogress noinline nounwind uwtable
+define dso_local noundef i32 @_Z8veryBusyii(i32 noundef %0, i32 noundef %1) #0 {
+  %3 = icmp ne i32 %0, %1
+  %4 = sub nsw i32 %1, %0
+  br i1 %3, label %5, label %7
+
+5:                                                ; preds = %2
+  %6 = sub nsw i32 %0, %1
+  br label %9
+
+7:                                                ; preds = %2
+  %8 = sub nsw i32 0, %1
+  br label %9
+
+9:                                                ; preds = %7, %5
+  %.01 = phi i32 [ %4, %5 ], [ %8, %7 ]
+  %.0 = phi i32 [ %6, %5 ], [ %4, %7 ]
+  %10 = add nsw i32 %.01, %.0
+  ret i32 %10
+}
+
+; Function Attrs: mustprogress noinline nounwind uwtable
+define dso_local noundef i32 @_Z9availablei(i32 noundef %0) #0 {
+  br label %2
+
+2:                                                ; preds = %7, %1
+  %.01 = phi i32 [ 0, %1 ], [ %6, %7 ]
+  %.0 = phi i32 [ 0, %1 ], [ %8, %7 ]
+  %3 = icmp slt i32 %.0, %0
+  %4 = mul nsw i32 %0, 2
+  br i1 %3, label %5, label %9
+
+5:                                                ; preds = %2
+  %6 = add nsw i32 %.01, %4
+  br label %7
+
+7:                                                ; preds = %5
+  %8 = add nsw i32 %.0, 1
+  br label %2, !llvm.loop !6
+
+9:                                                ; preds = %2
+  %10 = add nsw i32 %.01, %4
+  ret i32 %10
+}
+
+; Function Attrs: mustprogress noinline nounwind uwtable
+define dso_local noundef i32 @_Z8livenessii(i32 noundef %0, i32 noundef %1) #0 {
+  br label %3
+
+3:                                                ; preds = %8, %2
+  %.01 = phi i32 [ 0, %2 ], [ %7, %8 ]
+  %.0 = phi i32 [ 0, %2 ], [ %9, %8 ]
+  %4 = icmp slt i32 %.0, %0
+  br i1 %4, label %5, label %10
+
+5:                                                ; preds = %3
+  %6 = mul nsw i32 %.0, 3
+  %7 = add nsw i32 %.01, %6
+  br label %8
+
+8:                                                ; preds = %5
+  %9 = add nsw i32 %.0, 1
+  br label %3, !llvm.loop !8
+
+10:                                               ; preds = %3
+  %11 = add nsw i32 %.01, %1
+  ret i32 %11
+}
+
+; Function Attrs: mustprogress noinline nounwind uwtable
+define dso_local void @_Z4spiniibPi(i32 noundef %0, i32 noundef %1, i1 noundef zeroext %2, ptr noundef %3) #0 {
+  %5 = zext i1 %2 to i8
+  br label %6
+
+6:                                                ; preds = %13, %4
+  %7 = sub nsw i32 %0, %1
+  store i32 %7, ptr %3, align 4
+  %8 = trunc i8 %5 to i1
+  br i1 %8, label %9, label %11
+
+9:                                                ; preds = %6
+  %10 = mul nsw i32 %0, %1
+  store i32 %10, ptr %3, align 4
+  br label %13
+
+11:                                               ; preds = %6
+  %12 = add nsw i32 %0, %1
+  store i32 %12, ptr %3, align 4
+  br label %13
+
+13:                                               ; preds = %11, %9
+  br label %6, !llvm.loop !9
+}
+
+attributes #0 = { mustprogress noinline nounwind uwtable "frame-pointer"="all" "min-legal-vector-width"="0" "no-trapping-math"="true" "stack-protector-buffer-size"="8" "target-cpu"="x86-64" "target-features"="+cmov,+cx8,+fxsr,+mmx,+sse,+sse2,+x87" "tune-cpu"="generic" }
+
+!llvm.module.flags = !{!0, !1, !2, !3, !4}
+!llvm.ident = !{!5}
+
+!0 = !{i32 1, !"wchar_size", i32 4}
+!1 = !{i32 8, !"PIC Level", i32 2}
+!2 = !{i32 7, !"PIE Level", i32 2}
+!3 = !{i32 7, !"uwtable", i32 2}
+!4 = !{i32 7, !"frame-pointer", i32 2}
+!5 = !{!"Ubuntu clang version 19.1.7 (++20250114103320+cd708029e0b2-1~exp1~20250114103432.75)"}
+!6 = distinct !{!6, !7}
+!7 = !{!"llvm.loop.mustprogress"}
+!8 = distinct !{!8, !7}
+!9 = distinct !{!9, !7}
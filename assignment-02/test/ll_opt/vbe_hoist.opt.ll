@@ -0,0 +1,72 @@
+; ModuleID = 'test/bc/vbe_hoist.opt.bc'
+source_filename = "test/cpp/vbe_hoist.cpp"
+target datalayout = "e-m:e-p270:32:32-p271:32:32-p272:64:64-i64:64-i128:128-f80:128-n8:16:32:64-S128"
+target triple = "x86_64-pc-linux-gnu"
+
+; Function Attrs: mustprogress noinline nounwind uwtable
+define dso_local noundef i32 @_Z9hoistBothiib(i32 noundef %0, i32 noundef %1, i1 noundef zeroext %2) #0 {
+  %4 = zext i1 %2 to i8
+  %5 = trunc i8 %4 to i1
+  %6 = sub nsw i32 %1, %0
+  br i1 %5, label %7, label %9
+
+7:                                                ; preds = %3
+  %8 = mul nsw i32 %6, 2
+  br label %11
+
+9:                                                ; preds = %3
+  %10 = add nsw i32 %6, 7
+  br label %11
+
+11:                                               ; preds = %9, %7
+  %.0 = phi i32 [ %8, %7 ], [ %10, %9 ]
+  ret i32 %.0
+}
+
+; Function Attrs: mustprogress noinline nounwind uwtable
+define dso_local noundef i32 @_Z7onePathiib(i32 noundef %0, i32 noundef %1, i1 noundef zeroext %2) #0 {
+  %4 = zext i1 %2 to i8
+  %5 = trunc i8 %4 to i1
+  br i1 %5, label %6, label %8
+
+6:                                                ; preds = %3
+  %7 = mul nsw i32 %0, %1
+  br label %8
+
+8:                                                ; preds = %6, %3
+  %.0 = phi i32 [ %7, %6 ], [ 0, %3 ]
+  ret i32 %.0
+}
+
+; Function Attrs: mustprogress noinline nounwind uwtable
+define dso_local noundef i32 @_Z8divisioniib(i32 noundef %0, i32 noundef %1, i1 noundef zeroext %2) #0 {
+  %4 = zext i1 %2 to i8
+  %5 = trunc i8 %4 to i1
+  br i1 %5, label %6, label %9
+
+6:                                                ; preds = %3
+  %7 = sdiv i32 %0, %1
+  %8 = add nsw i32 %7, 1
+  br label %12
+
+9:                                                ; preds = %3
+  %10 = sdiv i32 %0, %1
+  %11 = sub nsw i32 %10, 1
+  br label %12
+
+12:                                               ; preds = %9, %6
+  %.0 = phi i32 [ %8, %6 ], [ %11, %9 ]
+  ret i32 %.0
+}
+
+attributes #0 = { mustprogress noinline nounwind uwtable "frame-pointer"="all" "min-legal-vector-width"="0" "no-trapping-math"="true" "stack-protector-buffer-size"="8" "target-cpu"="x86-64" "target-features"="+cmov,+cx8,+fxsr,+mmx,+sse,+sse2,+x87" "tune-cpu"="generic" }
+
+!llvm.module.flags = !{!0, !1, !2, !3, !4}
+!llvm.ident = !{!5}
+
+!0 = !{i32 1, !"wchar_size", i32 4}
+!1 = !{i32 8, !"PIC Level", i32 2}
+!2 = !{i32 7, !"PIE Level", i32 2}
+!3 = !{i32 7, !"uwtable", i32 2}
+!4 = !{i32 7, !"frame-pointer", i32 2}
+!5 = !{!"Ubuntu clang version 19.1.7 (++20250114103320+cd708029e0b2-1~exp1~20250114103432.75)"}
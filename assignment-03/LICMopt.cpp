@@ -1,22 +1,111 @@
 #include "LICMopt.h"
+#include "LoopUnswitch.h"
+
+#include "llvm/ADT/Statistic.h"
 using namespace llvm;
 
-PreservedAnalyses LICMopt::run(Function &F, FunctionAnalysisManager &FAM) {
-  outs() << "\n" << "Running LICMopt on function: " << F.getName() << "\n";
+#define DEBUG_TYPE "LICM-opt"
+
+STATISTIC(NumHoisted, "Loop invariants moved to the preheader");
+STATISTIC(NumMerged, "Loop invariants merged into a copy already hoisted");
+STATISTIC(NumNotSafe, "Loop invariants not safe to move");
+STATISTIC(NumCold, "Loops skipped: cold");
+
+// Hoisting from the loops that seldom run only grows their preheaders
+static bool isHot(Loop *L, const LoopHotness &Hotness, OptimizationRemarkEmitter &ORE) {
+  if (Hotness.isHot(L)) return true;
+
+  ++NumCold;
+  ORE.emit([&] {
+    return OptimizationRemarkMissed(DEBUG_TYPE, "ColdLoop", L->getStartLoc(), L->getHeader())
+           << "nothing hoisted out of the loop: it is cold";
+  });
+  return false;
+}
+
+// Expressions evaluated on every iteration of L, whatever path it takes: the
+// very busy expressions at the header, with the backedges and the exits as
+// boundary. The blocks of a nested loop that never exits also meet it.
+static BitVector getBusyOnEveryIteration(Loop *L, const ExpressionUniverse &Exprs) {
+  BasicBlock *header = L->getHeader();
+  ArrayRef<BasicBlock*> blocks = L->getBlocks();
+  DenseMap<const BasicBlock*, unsigned> index;
+  for (unsigned i = 0; i < blocks.size(); ++i)
+    index[blocks[i]] = i;
+
+  auto endsIteration = [&](BasicBlock *Succ) { return Succ == header || !L->contains(Succ); };
+
+  // The operands of the expressions looked up are invariant: nothing is killed
+  SmallVector<BitVector, 8> gen(blocks.size(), BitVector(Exprs.size()));
+  BitVector noEnd(blocks.size(), true);
+  SmallVector<unsigned, 8> worklist;
+  for (unsigned i = 0; i < blocks.size(); ++i) {
+    for (Instruction &I : *blocks[i])
+      if (int Idx = Exprs.getIndex(I); Idx >= 0) gen[i].set(Idx);
+
+    if (any_of(successors(blocks[i]), endsIteration)) {
+      noEnd.reset(i);
+      worklist.push_back(i);
+    }
+  }
+  while (!worklist.empty()) {
+    for (BasicBlock *Pred : predecessors(blocks[worklist.pop_back_val()])) {
+      auto it = index.find(Pred);
+      if (it != index.end() && noEnd.test(it->second)) {
+        noEnd.reset(it->second);
+        worklist.push_back(it->second);
+      }
+    }
+  }
+
+  SmallVector<BitVector, 8> in(blocks.size(), BitVector(Exprs.size(), true));
+  BitVector out(Exprs.size());
+  for (bool changed = true; changed;) {
+    changed = false;
+    for (unsigned i = blocks.size(); i-- > 0;) {
+      out.set();
+      for (BasicBlock *Succ : successors(blocks[i]))
+        if (endsIteration(Succ)) out.reset();
+        else out &= in[index[Succ]];
+      if (noEnd.test(i)) out.reset();
 
+      out |= gen[i];
+      if (out != in[i]) {
+        in[i] = out;
+        changed = true;
+      }
+    }
+  }
+  return in[index[header]];
+}
+
+PreservedAnalyses LICMopt::run(Function &F, FunctionAnalysisManager &FAM) {
   auto &LI = FAM.getResult<LoopAnalysis>(F);
   auto &DT = FAM.getResult<DominatorTreeAnalysis>(F);
+  auto &VBE = FAM.getResult<VeryBusyExpressionsAnalysis>(F);
+  auto &ORE = FAM.getResult<OptimizationRemarkEmitterAnalysis>(F);
+  LoopHotness hotness = LoopHotness::get(F, FAM);
   bool changed = false;
 
   for (Loop *L : LI) 
-    changed |= runOnLoop(L, DT);
+    if (isHot(L, hotness, ORE))
+      changed |= runOnLoop(L, DT, &VBE, ORE);
 
   return changed ? PreservedAnalyses::none() : PreservedAnalyses::all();
 }
 
-bool LICMopt::runOnLoop(Loop *L, DominatorTree &DT) {
+bool LICMopt::runOnLoop(Loop *L, DominatorTree &DT, const ExpressionDataflowInfo *VBE,
+                        OptimizationRemarkEmitter &ORE) {
+  TimeTraceScope scope("LICMopt loop", [&] { return L->getHeader()->getName().str(); });
+
   BasicBlock *preheader = L->getLoopPreheader();
-  if (!preheader) return false;
+  if (!preheader) {
+    ORE.emit([&] {
+      return OptimizationRemarkMissed(DEBUG_TYPE, "NoPreheader", L->getStartLoc(), L->getHeader())
+             << "nothing hoisted out of the loop: it has no preheader";
+    });
+    return false;
+  }
   SetVector<Instruction*> movable, moved;
 
   SmallVector<BasicBlock*> ExitBlocks;
@@ -24,37 +113,47 @@ bool LICMopt::runOnLoop(Loop *L, DominatorTree &DT) {
 
   // Check if an instruction is loop-invariant
   auto isLoopInvariant = [&](Instruction &I) -> bool {
-    if (!I.isBinaryOp())
-      return false;
-
-    for (Value *op : I.operands()) {
-      if (isa<Constant>(op) || isa<Argument>(op)) continue;
-
-      if (auto *OpInst = dyn_cast<Instruction>(op)) {
-        if (isa<PHINode>(OpInst))
-          return false;
-
-        if (!L->contains(OpInst) || movable.contains(OpInst))
-          continue;
+    return I.isBinaryOp() && hasInvariantOperands(I, L, movable);
+  };
 
-        return false;
-      }
-    }
-    return true;
+  // Evaluated on every iteration, even from conditional blocks: like the
+  // instructions dominating the exits, the hoisted copy adds no work to any
+  // path through the loop
+  BitVector busy = VBE ? getBusyOnEveryIteration(L, VBE->getExpressions()) : BitVector();
+  auto isVeryBusyInLoop = [&](Instruction &I) -> bool {
+    int Idx = VBE ? VBE->getExpressions().getIndex(I) : -1;
+    return Idx >= 0 && busy.test(Idx);
   };
 
   // Collect loop invariants and movable instructions
+  unsigned numInvariants = 0;
   for (BasicBlock *BB : depth_first(L->getHeader())) {
     if (!L->contains(BB)) continue;
 
     for (Instruction &I : *BB) {
-      if (isLoopInvariant(I) && isSafeToMove(I, L, DT, ExitBlocks)) {
+      if (!isLoopInvariant(I)) continue;
+      ++numInvariants;
+
+      const char *reason = nullptr;
+      if (isSafeToMove(I, L, DT, ExitBlocks, isVeryBusyInLoop(I), reason)) {
         movable.insert(&I);
-        outs() << "Found movable loopInvariant: " << I << "\n";
+        continue;
       }
+
+      ++NumNotSafe;
+      ORE.emit([&] {
+        return OptimizationRemarkMissed(DEBUG_TYPE, "NotSafeToMove", &I)
+               << "loop invariant " << ore::NV("Inst", &I) << " not hoisted: " << reason;
+      });
     }
   }
 
+  ORE.emit([&] {
+    return OptimizationRemarkAnalysis(DEBUG_TYPE, "Invariants", L->getStartLoc(), L->getHeader())
+           << ore::NV("Invariants", numInvariants) << " loop invariants, "
+           << ore::NV("Movable", unsigned(movable.size())) << " safe to move";
+  });
+
   // Check for not moved dependencies 
   // auto hasUnmovedDependencies = [&](Instruction *I) -> bool {
   //   for (Value *op : I->operands()) {
@@ -66,43 +165,78 @@ bool LICMopt::runOnLoop(Loop *L, DominatorTree &DT) {
   //   return false;
   // };
 
-  // Move instructions
+  // Move instructions, merging copies of an expression already hoisted
+  DenseMap<int, Instruction*> hoisted;
   for (Instruction *I : movable) {
+    int exprIdx = VBE ? VBE->getExpressions().getIndex(*I) : -1;
+    auto it = exprIdx >= 0 ? hoisted.find(exprIdx) : hoisted.end();
+
+    if (it != hoisted.end()) {
+      ++NumMerged;
+      ORE.emit([&] {
+        return OptimizationRemark(DEBUG_TYPE, "Merged", I)
+               << ore::NV("Inst", I) << " merged into the copy hoisted to the preheader";
+      });
+      it->second->andIRFlags(I);
+      I->replaceAllUsesWith(it->second);
+      I->eraseFromParent();
+      moved.insert(it->second);
+      continue;
+    }
+
     // if (!hasUnmovedDependencies(I)) {
       I->moveBefore(preheader->getTerminator());
       moved.insert(I);
-      outs() << "Moved to preheader: " << *I << "\n";
+      if (exprIdx >= 0) hoisted[exprIdx] = I;
+      ++NumHoisted;
+      ORE.emit([&] {
+        return OptimizationRemark(DEBUG_TYPE, "Hoisted", I)
+               << "hoisting " << ore::NV("Inst", I) << " to the preheader";
+      });
     // }
   }
 
   return !moved.empty();
 }
 
-bool LICMopt::isSafeToMove(Instruction &I, Loop *L, DominatorTree &DT, SmallVector<BasicBlock*> ExitBlocks){
+// Operands are constants, arguments, or instructions defined outside the loop
+// or already known to be invariant
+bool LICMopt::hasInvariantOperands(Instruction &I, Loop *L, const SetVector<Instruction*> &invariants) {
+  for (Value *op : I.operands()) {
+    if (isa<Constant>(op) || isa<Argument>(op)) continue;
+
+    if (auto *OpInst = dyn_cast<Instruction>(op)) {
+      if (isa<PHINode>(OpInst))
+        return false;
+
+      if (!L->contains(OpInst) || invariants.contains(OpInst))
+        continue;
+
+      return false;
+    }
+  }
+  return true;
+}
+
+bool LICMopt::isSafeToMove(Instruction &I, Loop *L, DominatorTree &DT, ArrayRef<BasicBlock*> ExitBlocks,
+                           bool EveryIteration, const char *&Reason){
   // Instruction is not used outside loop
   auto isDeadOutsideLoop = [&](Instruction &I) -> bool {
     for (User *user : I.users()) {
       if (Instruction *userInstr = dyn_cast<Instruction>(user)) {
-        if (!L->contains(userInstr)) {
-          outs() << "NOT dead after: " << I << "\n";
+        if (!L->contains(userInstr))
           return false;
-        }
       }
     }
-    outs() << "dead after: " << I << "\n";
     return true;
   };
 
   // Check if instruction will execute before any possible loop exit.
   auto dominatesAllExits = [&](Instruction &I) -> bool {
     for (BasicBlock *Exit : ExitBlocks) {
-      if (!DT.dominates(I.getParent(), Exit)) {
-        outs() << "NOT dominate exits: " << I << "\n";
+      if (!DT.dominates(I.getParent(), Exit))
         return false;
-      }
     }
-
-    outs() << "dominate exits: " << I << "\n";
     return true;
   };
 
@@ -110,13 +244,10 @@ bool LICMopt::isSafeToMove(Instruction &I, Loop *L, DominatorTree &DT, SmallVect
   auto definedOnlyOnce = [&](Instruction &I) -> bool {
     for (User *user : I.users()){  
       if (PHINode* phi = dyn_cast<PHINode>(user)){
-        if (L->contains(phi)){
-          outs() << "NOT defined only once: " << I << "\n";
+        if (L->contains(phi))
           return false; 
-        }
       }
     }
-    outs() << "defined only once: " << I << "\n";
     return true;
   };
 
@@ -125,25 +256,64 @@ bool LICMopt::isSafeToMove(Instruction &I, Loop *L, DominatorTree &DT, SmallVect
     for (User *user : I.users()) {
       if (Instruction *userInstr = dyn_cast<Instruction>(user)) {
         BasicBlock *userBlock = userInstr->getParent();
-        if (userBlock && !DT.dominates(I.getParent(), userBlock)) {
-          outs() << "NOT dominate all uses: " << I << "\n";
+        if (userBlock && !DT.dominates(I.getParent(), userBlock))
           return false;
-        }
       }
     }
-    outs() << "dominate all uses: " << I << "\n";
     return true;
   };
 
-  return (isDeadOutsideLoop(I) || dominatesAllExits(I)) && definedOnlyOnce(I) && dominatesAllUses(I);
+  if (!isDeadOutsideLoop(I) && !EveryIteration && !dominatesAllExits(I)) {
+    Reason = "used after the loop, and not evaluated on every iteration";
+    return false;
+  }
+  // A division guarded by a test of its divisor may trap once hoisted
+  if (!EveryIteration && !dominatesAllExits(I) && !isSafeToSpeculativelyExecute(&I)) {
+    Reason = "may trap, and is not evaluated on every iteration";
+    return false;
+  }
+  if (!definedOnlyOnce(I)) {
+    Reason = "used by a phi in the loop";
+    return false;
+  }
+  if (!dominatesAllUses(I)) {
+    Reason = "does not dominate all its uses";
+    return false;
+  }
+  return true;
 }
 
-PassPluginLibraryInfo getLocalOptPluginInfo() {
+// Inside a loop pipeline the function analyses cached before it may be stale,
+// so the very busy expressions are not used
+PreservedAnalyses LICMoptLoopPass::run(Loop &L, LoopAnalysisManager &LAM,
+                                       LoopStandardAnalysisResults &AR, LPMUpdater &U) {
+  Function &F = *L.getHeader()->getParent();
+  OptimizationRemarkEmitter ORE(&F);
+
+  ProfileSummaryInfo *PSI = nullptr;
+  if (auto *MAMProxy = LAM.getResult<FunctionAnalysisManagerLoopProxy>(L, AR)
+                          .getCachedResult<ModuleAnalysisManagerFunctionProxy>(F))
+    PSI = MAMProxy->getCachedResult<ProfileSummaryAnalysis>(*F.getParent());
+  if (!isHot(&L, LoopHotness(F, AR.LI, AR.BFI, PSI), ORE))
+    return PreservedAnalyses::all();
+
+  if (!LICMopt().runOnLoop(&L, AR.DT, nullptr, ORE))
+    return PreservedAnalyses::all();
+
+  AR.SE.forgetLoop(&L);
+  return getLoopPassPreservedAnalyses();
+}
+
+PassPluginLibraryInfo getLICMoptPluginInfo() {
   return {
     LLVM_PLUGIN_API_VERSION,
     "LICMopt",
     "v1.0",
     [](PassBuilder &PB) {
+      PB.registerAnalysisRegistrationCallback(
+        [](FunctionAnalysisManager &FAM) {
+          registerDFAAnalyses(FAM);
+        });
       PB.registerPipelineParsingCallback(
         [](StringRef Name, FunctionPassManager &FPM,
            ArrayRef<PassBuilder::PipelineElement>) {
@@ -151,13 +321,20 @@ PassPluginLibraryInfo getLocalOptPluginInfo() {
             FPM.addPass(LICMopt());
             return true;
           }
+          if (Name == "LoopUnswitch-opt") {
+            FPM.addPass(LoopUnswitchOpt());
+            return true;
+          }
           return false;
         });
     }
   };
 }
 
+// The unified plugin provides its own entry point
+#ifndef UNIFIED_PLUGIN
 extern "C" LLVM_ATTRIBUTE_WEAK ::llvm::PassPluginLibraryInfo
 llvmGetPassPluginInfo() {
-  return getLocalOptPluginInfo();
+  return getLICMoptPluginInfo();
 }
+#endif
@@ -13,19 +13,43 @@
 #include "llvm/IR/InstrTypes.h"
 #include "llvm/IR/Module.h"
 
+#include "DFA.h"
+#include "LoopProfile.h"
+
 #include "llvm/ADT/SetVector.h"
 #include "llvm/Analysis/LoopInfo.h"
+#include "llvm/Analysis/OptimizationRemarkEmitter.h"
+#include "llvm/Analysis/ScalarEvolution.h"
+#include "llvm/Analysis/ValueTracking.h"
 #include "llvm/IR/Dominators.h"
+#include "llvm/Support/TimeProfiler.h"
+#include "llvm/Transforms/Scalar/LoopPassManager.h"
 
 namespace llvm {
 
 class LICMopt : public PassInfoMixin<LICMopt> {
     public:
         PreservedAnalyses run(Function &F, FunctionAnalysisManager &FAM);
-        bool isSafeToMove(Instruction &I, Loop *L, DominatorTree &DT, SmallVector<BasicBlock*> ExitBlocks);
-        bool runOnLoop(Loop *L, DominatorTree &DT);
+        // EveryIteration: I is known to be evaluated on every iteration of L.
+        // When it is not safe, Reason is set to why
+        bool isSafeToMove(Instruction &I, Loop *L, DominatorTree &DT, ArrayRef<BasicBlock*> ExitBlocks,
+                          bool EveryIteration, const char *&Reason);
+        // VBE may be null: only the invariants safe to move are hoisted
+        bool runOnLoop(Loop *L, DominatorTree &DT, const ExpressionDataflowInfo *VBE,
+                       OptimizationRemarkEmitter &ORE);
+        static bool hasInvariantOperands(Instruction &I, Loop *L, const SetVector<Instruction*> &invariants);
         
     };
+
+// LICMopt on a single loop, for the loop pass pipelines
+class LICMoptLoopPass : public PassInfoMixin<LICMoptLoopPass> {
+    public:
+        PreservedAnalyses run(Loop &L, LoopAnalysisManager &LAM,
+                              LoopStandardAnalysisResults &AR, LPMUpdater &U);
+    };
 }
 
+// Pipeline names of this plugin, also registered by the unified plugin
+llvm::PassPluginLibraryInfo getLICMoptPluginInfo();
+
 #endif
\ No newline at end of file
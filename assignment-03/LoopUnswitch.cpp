@@ -0,0 +1,219 @@
+#include "LoopUnswitch.h"
+
+#include "llvm/ADT/Statistic.h"
+using namespace llvm;
+
+#define DEBUG_TYPE "LoopUnswitch-opt"
+
+STATISTIC(NumUnswitched, "Loops unswitched");
+STATISTIC(NumClonedInstructions, "Instructions cloned by unswitching");
+STATISTIC(NumCold, "Loops not unswitched: cold");
+
+// Loops larger than this are never cloned
+static constexpr unsigned MaxUnswitchLoopSize = 128;
+// Instructions that unswitching may add to a single function
+static constexpr unsigned UnswitchSizeBudget = 512;
+
+PreservedAnalyses LoopUnswitchOpt::run(Function &F, FunctionAnalysisManager &FAM) {
+  ORE = &FAM.getResult<OptimizationRemarkEmitterAnalysis>(F);
+  auto &LI = FAM.getResult<LoopAnalysis>(F);
+  auto &DT = FAM.getResult<DominatorTreeAnalysis>(F);
+  bool changed = false;
+  clonedInstructions = 0;
+  reportedTooLarge.clear();
+
+  // Cloning the loops that seldom run only grows the code. Reported once: the
+  // loop nest is rebuilt after every unswitch
+  LoopHotness hotness = LoopHotness::get(F, FAM);
+  for (Loop *L : LI.getLoopsInPreorder()) {
+    if (hotness.isHot(L)) continue;
+    ++NumCold;
+    ORE->emit([&] {
+      return OptimizationRemarkMissed(DEBUG_TYPE, "ColdLoop", L->getStartLoc(), L->getHeader())
+             << "loop not unswitched: it is cold";
+    });
+  }
+
+  // Unswitch one branch at a time, innermost loops first, and rebuild the
+  // loop nest so that the clones are unswitched on the remaining conditions
+  bool unswitched = true;
+  while (unswitched) {
+    unswitched = false;
+
+    // reverse() does not extend the lifetime of a temporary
+    SmallVector<Loop*, 4> loops = LI.getLoopsInPreorder();
+    for (Loop *L : reverse(loops)) {
+      if (!hotness.isHot(L) || !L->getLoopPreheader() || !L->hasDedicatedExits() ||
+          !L->isLCSSAForm(DT) || !L->isSafeToClone())
+        continue;
+
+      SetVector<Instruction*> condChain;
+      BranchInst *BI = findInvariantBranch(L, condChain);
+      if (BI && unswitchLoop(L, BI, condChain, DT)) {
+        unswitched = changed = true;
+        break;
+      }
+    }
+
+    if (unswitched) {
+      DT.recalculate(F);
+      LI.releaseMemory();
+      LI.analyze(DT);
+
+      // Both versions leave through the same exit blocks: give each its own,
+      // or neither could be unswitched again
+      for (Loop *L : LI.getLoopsInPreorder())
+        formDedicatedExitBlocks(L, &DT, &LI, nullptr, true);
+    }
+  }
+
+  return changed ? PreservedAnalyses::none() : PreservedAnalyses::all();
+}
+
+// The condition and the in-loop instructions it is computed from follow the
+// same invariance rules as LICMopt::isLoopInvariant
+bool LoopUnswitchOpt::isInvariantCondition(Value *V, Loop *L, SetVector<Instruction*> &condChain) {
+  auto *I = dyn_cast<Instruction>(V);
+  if (!I) return isa<Constant>(V) || isa<Argument>(V);
+  if (!L->contains(I) || condChain.contains(I)) return true;
+
+  if (!I->isBinaryOp() && !isa<CmpInst>(I) && !isa<CastInst>(I)) return false;
+  if (!isSafeToSpeculativelyExecute(I)) return false;
+
+  for (Value *op : I->operands()) {
+    auto *opInstr = dyn_cast<Instruction>(op);
+    if (opInstr && L->contains(opInstr) && !isa<PHINode>(opInstr) &&
+        !isInvariantCondition(opInstr, L, condChain))
+      return false;
+  }
+
+  if (!LICMopt::hasInvariantOperands(*I, L, condChain)) return false;
+
+  // Operands first, so the chain can be moved to the preheader in order
+  condChain.insert(I);
+  return true;
+}
+
+BranchInst *LoopUnswitchOpt::findInvariantBranch(Loop *L, SetVector<Instruction*> &condChain) {
+  BranchInst *candidate = nullptr;
+  for (BasicBlock *BB : L->blocks()) {
+    auto *BI = dyn_cast<BranchInst>(BB->getTerminator());
+    if (!BI || !BI->isConditional() || isa<Constant>(BI->getCondition())) continue;
+    if (BI->getSuccessor(0) == BI->getSuccessor(1)) continue;
+
+    condChain.clear();
+    if (isInvariantCondition(BI->getCondition(), L, condChain)) {
+      candidate = BI;
+      break;
+    }
+  }
+  if (!candidate) return nullptr;
+
+  unsigned loopSize = 0;
+  for (BasicBlock *BB : L->blocks())
+    loopSize += BB->size();
+
+  // Every round of unswitching looks at the loop again: reported once
+  if (loopSize > MaxUnswitchLoopSize || clonedInstructions + loopSize > UnswitchSizeBudget) {
+    if (reportedTooLarge.insert(L->getHeader()).second) {
+      ORE->emit([&] {
+        return OptimizationRemarkMissed(DEBUG_TYPE, "TooLarge", L->getStartLoc(), L->getHeader())
+               << "loop of " << ore::NV("Size", loopSize) << " instructions not unswitched: "
+               << (loopSize > MaxUnswitchLoopSize ? "larger than the clone limit"
+                                                  : "the function's unswitching budget is spent");
+      });
+    }
+    return nullptr;
+  }
+
+  clonedInstructions += loopSize;
+  NumClonedInstructions += loopSize;
+  return candidate;
+}
+
+bool LoopUnswitchOpt::unswitchLoop(Loop *L, BranchInst *BI, const SetVector<Instruction*> &condChain,
+                                   DominatorTree &DT) {
+  BasicBlock *preheader = L->getLoopPreheader();
+  BasicBlock *header = L->getHeader();
+  Function *F = header->getParent();
+  LLVMContext &Ctx = F->getContext();
+  Value *cond = BI->getCondition();
+
+  TimeTraceScope scope("LoopUnswitchOpt unswitch", header->getName());
+  ++NumUnswitched;
+  ORE->emit([&] {
+    return OptimizationRemark(DEBUG_TYPE, "Unswitched", BI)
+           << "loop unswitched on the invariant condition " << ore::NV("Cond", cond);
+  });
+
+  // Evaluate the condition once, before the loop
+  for (Instruction *I : condChain)
+    I->moveBefore(preheader->getTerminator());
+
+  // Branching on undef or poison is undefined, and the loop may exit before
+  // it reaches the branch: the hoisted test must not make it undefined
+  Value *test = cond;
+  if (!isGuaranteedNotToBeUndefOrPoison(cond, nullptr, preheader->getTerminator(), &DT))
+    test = new FreezeInst(cond, cond->getName() + ".fr", preheader->getTerminator());
+
+  // === Clone the loop: the original runs when cond is true, the clone when false ===
+  ValueToValueMapTy VMap;
+  SmallVector<BasicBlock*> clonedBlocks;
+  for (BasicBlock *BB : L->blocks()) {
+    BasicBlock *clone = CloneBasicBlock(BB, VMap, ".us", F);
+    VMap[BB] = clone;
+    clonedBlocks.push_back(clone);
+  }
+  remapInstructionsInBlocks(clonedBlocks, VMap);
+
+  // === One preheader per version, the test in the old preheader ===
+  BasicBlock *truePreheader = BasicBlock::Create(Ctx, preheader->getName() + ".us.true", F, header);
+  BasicBlock *falsePreheader = BasicBlock::Create(Ctx, preheader->getName() + ".us.false", F, header);
+  auto *clonedHeader = cast<BasicBlock>(VMap[header]);
+
+  BranchInst::Create(header, truePreheader);
+  BranchInst::Create(clonedHeader, falsePreheader);
+  header->replacePhiUsesWith(preheader, truePreheader);
+  clonedHeader->replacePhiUsesWith(preheader, falsePreheader);
+
+  preheader->getTerminator()->eraseFromParent();
+  BranchInst::Create(truePreheader, falsePreheader, test, preheader);
+
+  // === Exit blocks are shared: add the incoming values of the clone ===
+  SmallVector<BasicBlock*> exitBlocks;
+  L->getUniqueExitBlocks(exitBlocks);
+  for (BasicBlock *exit : exitBlocks) {
+    for (PHINode &PN : exit->phis()) {
+      for (unsigned i = 0, e = PN.getNumIncomingValues(); i < e; ++i) {
+        BasicBlock *incoming = PN.getIncomingBlock(i);
+        if (!L->contains(incoming)) continue;
+
+        Value *V = PN.getIncomingValue(i);
+        Value *clonedV = VMap.lookup(V);
+        PN.addIncoming(clonedV ? clonedV : V, cast<BasicBlock>(VMap[incoming]));
+      }
+    }
+  }
+
+  // === Fold every branch on cond in each version ===
+  auto foldBranches = [&](ArrayRef<BasicBlock*> blocks, bool value) {
+    for (BasicBlock *BB : blocks) {
+      auto *branch = dyn_cast<BranchInst>(BB->getTerminator());
+      if (!branch || !branch->isConditional() || branch->getCondition() != cond) continue;
+
+      BasicBlock *taken = branch->getSuccessor(!value);
+      BasicBlock *notTaken = branch->getSuccessor(value);
+      notTaken->removePredecessor(BB);
+      BranchInst::Create(taken, branch);
+      branch->eraseFromParent();
+    }
+  };
+
+  SmallVector<BasicBlock*> originalBlocks(L->blocks());
+  foldBranches(originalBlocks, true);
+  foldBranches(clonedBlocks, false);
+
+  // Blocks only reached through the folded side
+  removeUnreachableBlocks(*F);
+  return true;
+}
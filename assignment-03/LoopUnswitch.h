@@ -0,0 +1,29 @@
+#ifndef LOOP_UNSWITCH_OPT_H
+#define LOOP_UNSWITCH_OPT_H
+
+#include "LICMopt.h"
+
+#include "llvm/ADT/SmallPtrSet.h"
+#include "llvm/Transforms/Utils/Cloning.h"
+#include "llvm/Transforms/Utils/Local.h"
+#include "llvm/Transforms/Utils/LoopUtils.h"
+#include "llvm/Transforms/Utils/ValueMapper.h"
+
+namespace llvm {
+
+class LoopUnswitchOpt : public PassInfoMixin<LoopUnswitchOpt> {
+    public:
+        PreservedAnalyses run(Function &F, FunctionAnalysisManager &FAM);
+        BranchInst *findInvariantBranch(Loop *L, SetVector<Instruction*> &condChain);
+        bool unswitchLoop(Loop *L, BranchInst *BI, const SetVector<Instruction*> &condChain, DominatorTree &DT);
+        static bool isInvariantCondition(Value *V, Loop *L, SetVector<Instruction*> &condChain);
+
+    private:
+        unsigned clonedInstructions = 0;
+        // Headers of the loops already reported as too large to clone
+        SmallPtrSet<const BasicBlock*, 8> reportedTooLarge;
+        OptimizationRemarkEmitter *ORE = nullptr;
+    };
+}
+
+#endif
@@ -51,3 +51,45 @@ void test4(int n) {
     }
 }
 
+
+// MOVABLE (VBE): n * 3 is evaluated on both branches, so it is very busy at
+// the header; the two copies are merged in the preheader
+int test5(int n, bool cond) {
+    int sum = 0;
+
+    for (int x = 0; x < 20; x++) {
+        if (cond)
+            sum += n * 3;
+        else
+            sum -= n * 3;
+    }
+
+    return sum;
+}
+
+// NOT MOVABLE: n / d may trap, and is only evaluated when d is not 0
+int test6(int n, int d) {
+    int sum = 0;
+
+    for (int x = 0; x < 20; x++) {
+        if (d != 0)
+            sum += n / d;
+    }
+
+    return sum;
+}
+
+// MOVABLE (VBE): n / d is evaluated on every iteration, whatever the branch,
+// so hoisting it adds no trap
+int test7(int n, int d, bool cond) {
+    int sum = 0;
+
+    for (int x = 0; x < 20; x++) {
+        if (cond)
+            sum += n / d;
+        else
+            sum -= n / d;
+    }
+
+    return sum;
+}
@@ -0,0 +1,54 @@
+// UNSWITCHED: mode == 3 is invariant, the test moves to the preheader and
+// each loop version keeps one side of the branch
+int invariantMode(int n, int mode) {
+    int sum = 0;
+
+    for (int i = 0; i < n; i++) {
+        if (mode == 3)
+            sum += i;
+        else
+            sum -= i;
+    }
+
+    return sum;
+}
+
+// UNSWITCHED: two invariant switches, one loop version per combination
+void twoSwitches(int a[], int n, bool scale, bool offset) {
+    for (int i = 0; i < n; i++) {
+        int v = a[i];
+        if (scale)
+            v = v * 2;
+        if (offset)
+            v = v + 7;
+        a[i] = v;
+    }
+}
+
+// NOT UNSWITCHED: the condition depends on the induction variable
+int variantCond(int n) {
+    int sum = 0;
+
+    for (int i = 0; i < n; i++) {
+        if (i % 2 == 0)
+            sum += i;
+    }
+
+    return sum;
+}
+
+// UNSWITCHED: f may be undef, and the test before the loop runs even when the
+// loop would have left before the branch, so it is frozen first
+int frozenFlag(const int *flag, int n) {
+    int sum = 0;
+    int f = *flag;
+
+    for (int i = 0; i < n; i++) {
+        if (f)
+            sum += i;
+        else
+            sum -= i;
+    }
+
+    return sum;
+}
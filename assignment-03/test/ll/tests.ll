@@ -115,6 +115,111 @@ define dso_local void @_Z5test4i(i32 noundef %0) #0 {
   ret void
 }
 
+; Function Attrs: mustprogress noinline nounwind uwtable
+define dso_local noundef i32 @_Z5test5ib(i32 noundef %0, i1 noundef zeroext %1) #0 {
+  %3 = zext i1 %1 to i8
+  br label %4
+
+4:                                                ; preds = %15, %2
+  %.01 = phi i32 [ 0, %2 ], [ %.1, %15 ]
+  %.0 = phi i32 [ 0, %2 ], [ %16, %15 ]
+  %5 = icmp slt i32 %.0, 20
+  br i1 %5, label %6, label %17
+
+6:                                                ; preds = %4
+  %7 = trunc i8 %3 to i1
+  br i1 %7, label %8, label %11
+
+8:                                                ; preds = %6
+  %9 = mul nsw i32 %0, 3
+  %10 = add nsw i32 %.01, %9
+  br label %14
+
+11:                                               ; preds = %6
+  %12 = mul nsw i32 %0, 3
+  %13 = sub nsw i32 %.01, %12
+  br label %14
+
+14:                                               ; preds = %11, %8
+  %.1 = phi i32 [ %10, %8 ], [ %13, %11 ]
+  br label %15
+
+15:                                               ; preds = %14
+  %16 = add nsw i32 %.0, 1
+  br label %4, !llvm.loop !11
+
+17:                                               ; preds = %4
+  ret i32 %.01
+}
+
+; Function Attrs: mustprogress noinline nounwind uwtable
+define dso_local noundef i32 @_Z5test6ii(i32 noundef %0, i32 noundef %1) #0 {
+  br label %3
+
+3:                                                ; preds = %11, %2
+  %.01 = phi i32 [ 0, %2 ], [ %.1, %11 ]
+  %.0 = phi i32 [ 0, %2 ], [ %12, %11 ]
+  %4 = icmp slt i32 %.0, 20
+  br i1 %4, label %5, label %13
+
+5:                                                ; preds = %3
+  %6 = icmp ne i32 %1, 0
+  br i1 %6, label %7, label %10
+
+7:                                                ; preds = %5
+  %8 = sdiv i32 %0, %1
+  %9 = add nsw i32 %.01, %8
+  br label %10
+
+10:                                               ; preds = %7, %5
+  %.1 = phi i32 [ %9, %7 ], [ %.01, %5 ]
+  br label %11
+
+11:                                               ; preds = %10
+  %12 = add nsw i32 %.0, 1
+  br label %3, !llvm.loop !12
+
+13:                                               ; preds = %3
+  ret i32 %.01
+}
+
+; Function Attrs: mustprogress noinline nounwind uwtable
+define dso_local noundef i32 @_Z5test7iib(i32 noundef %0, i32 noundef %1, i1 noundef zeroext %2) #0 {
+  %4 = zext i1 %2 to i8
+  br label %5
+
+5:                                                ; preds = %16, %3
+  %.01 = phi i32 [ 0, %3 ], [ %.1, %16 ]
+  %.0 = phi i32 [ 0, %3 ], [ %17, %16 ]
+  %6 = icmp slt i32 %.0, 20
+  br i1 %6, label %7, label %18
+
+7:                                                ; preds = %5
+  %8 = trunc i8 %4 to i1
+  br i1 %8, label %9, label %12
+
+9:                                                ; preds = %7
+  %10 = sdiv i32 %0, %1
+  %11 = add nsw i32 %.01, %10
+  br label %15
+
+12:                                               ; preds = %7
+  %13 = sdiv i32 %0, %1
+  %14 = sub nsw i32 %.01, %13
+  br label %15
+
+15:                                               ; preds = %12, %9
+  %.1 = phi i32 [ %11, %9 ], [ %14, %12 ]
+  br label %16
+
+16:                                               ; preds = %15
+  %17 = add nsw i32 %.0, 1
+  br label %5, !llvm.loop !13
+
+18:                                               ; preds = %5
+  ret i32 %.01
+}
+
 attributes #0 = { mustprogress noinline nounwind uwtable "frame-pointer"="all" "min-legal-vector-width"="0" "no-trapping-math"="true" "stack-protector-buffer-size"="8" "target-cpu"="x86-64" "target-features"="+cmov,+cx8,+fxsr,+mmx,+sse,+sse2,+x87" "tune-cpu"="generic" }
 
 !llvm.module.flags = !{!0, !1, !2, !3, !4}
@@ -131,3 +236,6 @@ attributes #0 = { mustprogress noinline nounwind uwtable "frame-pointer"="all" "
 !8 = distinct !{!8, !7}
 !9 = distinct !{!9, !7}
 !10 = distinct !{!10, !7}
+!11 = distinct !{!11, !7}
+!12 = distinct !{!12, !7}
+!13 = distinct !{!13, !7}
@@ -0,0 +1,167 @@
+; ModuleID = 'test/bc/unswitch.bc'
+source_filename = "test/cpp/unswitch.cpp"
+target datalayout = "e-m:e-p270:32:32-p271:32:32-p272:64:64-i64:64-i128:128-f80:128-n8:16:32:64-S128"
+target triple = "x86_64-pc-linux-gnu"
+
+; Function Attrs: mustprogress noinline nounwind uwtable
+define dso_local noundef i32 @_Z13invariantModeii(i32 noundef %0, i32 noundef %1) #0 {
+  br label %3
+
+3:                                                ; preds = %12, %2
+  %.01 = phi i32 [ 0, %2 ], [ %.1, %12 ]
+  %.0 = phi i32 [ 0, %2 ], [ %13, %12 ]
+  %4 = icmp slt i32 %.0, %0
+  br i1 %4, label %5, label %14
+
+5:                                                ; preds = %3
+  %6 = icmp eq i32 %1, 3
+  br i1 %6, label %7, label %9
+
+7:                                                ; preds = %5
+  %8 = add nsw i32 %.01, %.0
+  br label %11
+
+9:                                                ; preds = %5
+  %10 = sub nsw i32 %.01, %.0
+  br label %11
+
+11:                                               ; preds = %9, %7
+  %.1 = phi i32 [ %8, %7 ], [ %10, %9 ]
+  br label %12
+
+12:                                               ; preds = %11
+  %13 = add nsw i32 %.0, 1
+  br label %3, !llvm.loop !6
+
+14:                                               ; preds = %3
+  ret i32 %.01
+}
+
+; Function Attrs: mustprogress noinline nounwind uwtable
+define dso_local void @_Z11twoSwitchesPiibb(ptr noundef %0, i32 noundef %1, i1 noundef zeroext %2, i1 noundef zeroext %3) #0 {
+  %5 = zext i1 %2 to i8
+  %6 = zext i1 %3 to i8
+  br label %7
+
+7:                                                ; preds = %23, %4
+  %.01 = phi i32 [ 0, %4 ], [ %24, %23 ]
+  %8 = icmp slt i32 %.01, %1
+  br i1 %8, label %9, label %25
+
+9:                                                ; preds = %7
+  %10 = sext i32 %.01 to i64
+  %11 = getelementptr inbounds i32, ptr %0, i64 %10
+  %12 = load i32, ptr %11, align 4
+  %13 = trunc i8 %5 to i1
+  br i1 %13, label %14, label %16
+
+14:                                               ; preds = %9
+  %15 = mul nsw i32 %12, 2
+  br label %16
+
+16:                                               ; preds = %14, %9
+  %.0 = phi i32 [ %15, %14 ], [ %12, %9 ]
+  %17 = trunc i8 %6 to i1
+  br i1 %17, label %18, label %20
+
+18:                                               ; preds = %16
+  %19 = add nsw i32 %.0, 7
+  br label %20
+
+20:                                               ; preds = %18, %16
+  %.1 = phi i32 [ %19, %18 ], [ %.0, %16 ]
+  %21 = sext i32 %.01 to i64
+  %22 = getelementptr inbounds i32, ptr %0, i64 %21
+  store i32 %.1, ptr %22, align 4
+  br label %23
+
+23:                                               ; preds = %20
+  %24 = add nsw i32 %.01, 1
+  br label %7, !llvm.loop !8
+
+25:                                               ; preds = %7
+  ret void
+}
+
+; Function Attrs: mustprogress noinline nounwind uwtable
+define dso_local noundef i32 @_Z11variantCondi(i32 noundef %0) #0 {
+  br label %2
+
+2:                                                ; preds = %10, %1
+  %.01 = phi i32 [ 0, %1 ], [ %.1, %10 ]
+  %.0 = phi i32 [ 0, %1 ], [ %11, %10 ]
+  %3 = icmp slt i32 %.0, %0
+  br i1 %3, label %4, label %12
+
+4:                                                ; preds = %2
+  %5 = srem i32 %.0, 2
+  %6 = icmp eq i32 %5, 0
+  br i1 %6, label %7, label %9
+
+7:                                                ; preds = %4
+  %8 = add nsw i32 %.01, %.0
+  br label %9
+
+9:                                                ; preds = %7, %4
+  %.1 = phi i32 [ %8, %7 ], [ %.01, %4 ]
+  br label %10
+
+10:                                               ; preds = %9
+  %11 = add nsw i32 %.0, 1
+  br label %2, !llvm.loop !9
+
+12:                                               ; preds = %2
+  ret i32 %.01
+}
+
+; Function Attrs: mustprogress noinline nounwind uwtable
+define dso_local noundef i32 @_Z10frozenFlagPKii(ptr noundef %0, i32 noundef %1) #0 {
+  %3 = load i32, ptr %0, align 4
+  br label %4
+
+4:                                                ; preds = %13, %2
+  %.01 = phi i32 [ 0, %2 ], [ %.1, %13 ]
+  %.0 = phi i32 [ 0, %2 ], [ %14, %13 ]
+  %5 = icmp slt i32 %.0, %1
+  br i1 %5, label %6, label %15
+
+6:                                                ; preds = %4
+  %7 = icmp ne i32 %3, 0
+  br i1 %7, label %8, label %10
+
+8:                                                ; preds = %6
+  %9 = add nsw i32 %.01, %.0
+  br label %12
+
+10:                                               ; preds = %6
+  %11 = sub nsw i32 %.01, %.0
+  br label %12
+
+12:                                               ; preds = %10, %8
+  %.1 = phi i32 [ %9, %8 ], [ %11, %10 ]
+  br label %13
+
+13:                                               ; preds = %12
+  %14 = add nsw i32 %.0, 1
+  br label %4, !llvm.loop !10
+
+15:                                               ; preds = %4
+  ret i32 %.01
+}
+
+attributes #0 = { mustprogress noinline nounwind uwtable "frame-pointer"="all" "min-legal-vector-width"="0" "no-trapping-math"="true" "stack-protector-buffer-size"="8" "target-cpu"="x86-64" "target-features"="+cmov,+cx8,+fxsr,+mmx,+sse,+sse2,+x87" "tune-cpu"="generic" }
+
+!llvm.module.flags = !{!0, !1, !2, !3, !4}
+!llvm.ident = !{!5}
+
+!0 = !{i32 1, !"wchar_size", i32 4}
+!1 = !{i32 8, !"PIC Level", i32 2}
+!2 = !{i32 7, !"PIE Level", i32 2}
+!3 = !{i32 7, !"uwtable", i32 2}
+!4 = !{i32 7, !"frame-pointer", i32 2}
+!5 = !{!"Ubuntu clang version 19.1.7 (++20250114103320+cd708029e0b2-1~exp1~20250114103432.75)"}
+!6 = distinct !{!6, !7}
+!7 = !{!"llvm.loop.mustprogress"}
+!8 = distinct !{!8, !7}
+!9 = distinct !{!9, !7}
+!10 = distinct !{!10, !7}
@@ -0,0 +1,191 @@
+; ModuleID = 'test/bc/unswitch.pre.bc'
+source_filename = "test/cpp/unswitch.cpp"
+target datalayout = "e-m:e-p270:32:32-p271:32:32-p272:64:64-i64:64-i128:128-f80:128-n8:16:32:64-S128"
+target triple = "x86_64-pc-linux-gnu"
+
+; Function Attrs: mustprogress noinline nounwind uwtable
+define dso_local noundef i32 @_Z13invariantModeii(i32 noundef %0, i32 noundef %1) #0 {
+  %3 = icmp slt i32 0, %0
+  br i1 %3, label %.lr.ph, label %14
+
+.lr.ph:                                           ; preds = %2
+  br label %4
+
+4:                                                ; preds = %.lr.ph, %11
+  %.02 = phi i32 [ 0, %.lr.ph ], [ %12, %11 ]
+  %.011 = phi i32 [ 0, %.lr.ph ], [ %.1, %11 ]
+  %5 = icmp eq i32 %1, 3
+  br i1 %5, label %6, label %8
+
+6:                                                ; preds = %4
+  %7 = add nsw i32 %.011, %.02
+  br label %10
+
+8:                                                ; preds = %4
+  %9 = sub nsw i32 %.011, %.02
+  br label %10
+
+10:                                               ; preds = %8, %6
+  %.03 = phi i32 [ %.02, %6 ], [ %.02, %8 ]
+  %.1 = phi i32 [ %7, %6 ], [ %9, %8 ]
+  br label %11
+
+11:                                               ; preds = %10
+  %12 = add nsw i32 %.03, 1
+  %13 = icmp slt i32 %12, %0
+  br i1 %13, label %4, label %._crit_edge, !llvm.loop !6
+
+._crit_edge:                                      ; preds = %11
+  %split = phi i32 [ %.1, %11 ]
+  br label %14
+
+14:                                               ; preds = %._crit_edge, %2
+  %.01.lcssa = phi i32 [ %split, %._crit_edge ], [ 0, %2 ]
+  ret i32 %.01.lcssa
+}
+
+; Function Attrs: mustprogress noinline nounwind uwtable
+define dso_local void @_Z11twoSwitchesPiibb(ptr noundef %0, i32 noundef %1, i1 noundef zeroext %2, i1 noundef zeroext %3) #0 {
+  %5 = zext i1 %2 to i8
+  %6 = zext i1 %3 to i8
+  %7 = icmp slt i32 0, %1
+  br i1 %7, label %.lr.ph, label %25
+
+.lr.ph:                                           ; preds = %4
+  br label %8
+
+8:                                                ; preds = %.lr.ph, %22
+  %.011 = phi i32 [ 0, %.lr.ph ], [ %23, %22 ]
+  %9 = sext i32 %.011 to i64
+  %10 = getelementptr inbounds i32, ptr %0, i64 %9
+  %11 = load i32, ptr %10, align 4
+  %12 = trunc i8 %5 to i1
+  br i1 %12, label %13, label %15
+
+13:                                               ; preds = %8
+  %14 = mul nsw i32 %11, 2
+  br label %15
+
+15:                                               ; preds = %13, %8
+  %.0 = phi i32 [ %14, %13 ], [ %11, %8 ]
+  %16 = trunc i8 %6 to i1
+  br i1 %16, label %17, label %19
+
+17:                                               ; preds = %15
+  %18 = add nsw i32 %.0, 7
+  br label %19
+
+19:                                               ; preds = %17, %15
+  %.1 = phi i32 [ %18, %17 ], [ %.0, %15 ]
+  %20 = sext i32 %.011 to i64
+  %21 = getelementptr inbounds i32, ptr %0, i64 %20
+  store i32 %.1, ptr %21, align 4
+  br label %22
+
+22:                                               ; preds = %19
+  %23 = add nsw i32 %.011, 1
+  %24 = icmp slt i32 %23, %1
+  br i1 %24, label %8, label %._crit_edge, !llvm.loop !8
+
+._crit_edge:                                      ; preds = %22
+  br label %25
+
+25:                                               ; preds = %._crit_edge, %4
+  ret void
+}
+
+; Function Attrs: mustprogress noinline nounwind uwtable
+define dso_local noundef i32 @_Z11variantCondi(i32 noundef %0) #0 {
+  %2 = icmp slt i32 0, %0
+  br i1 %2, label %.lr.ph, label %12
+
+.lr.ph:                                           ; preds = %1
+  br label %3
+
+3:                                                ; preds = %.lr.ph, %9
+  %.02 = phi i32 [ 0, %.lr.ph ], [ %10, %9 ]
+  %.011 = phi i32 [ 0, %.lr.ph ], [ %.1, %9 ]
+  %4 = srem i32 %.02, 2
+  %5 = icmp eq i32 %4, 0
+  br i1 %5, label %6, label %8
+
+6:                                                ; preds = %3
+  %7 = add nsw i32 %.011, %.02
+  br label %8
+
+8:                                                ; preds = %6, %3
+  %.1 = phi i32 [ %7, %6 ], [ %.011, %3 ]
+  br label %9
+
+9:                                                ; preds = %8
+  %10 = add nsw i32 %.02, 1
+  %11 = icmp slt i32 %10, %0
+  br i1 %11, label %3, label %._crit_edge, !llvm.loop !9
+
+._crit_edge:                                      ; preds = %9
+  %split = phi i32 [ %.1, %9 ]
+  br label %12
+
+12:                                               ; preds = %._crit_edge, %1
+  %.01.lcssa = phi i32 [ %split, %._crit_edge ], [ 0, %1 ]
+  ret i32 %.01.lcssa
+}
+
+; Function Attrs: mustprogress noinline nounwind uwtable
+define dso_local noundef i32 @_Z10frozenFlagPKii(ptr noundef %0, i32 noundef %1) #0 {
+  %3 = load i32, ptr %0, align 4
+  %4 = icmp slt i32 0, %1
+  br i1 %4, label %.lr.ph, label %15
+
+.lr.ph:                                           ; preds = %2
+  br label %5
+
+5:                                                ; preds = %.lr.ph, %12
+  %.02 = phi i32 [ 0, %.lr.ph ], [ %13, %12 ]
+  %.011 = phi i32 [ 0, %.lr.ph ], [ %.1, %12 ]
+  %6 = icmp ne i32 %3, 0
+  br i1 %6, label %7, label %9
+
+7:                                                ; preds = %5
+  %8 = add nsw i32 %.011, %.02
+  br label %11
+
+9:                                                ; preds = %5
+  %10 = sub nsw i32 %.011, %.02
+  br label %11
+
+11:                                               ; preds = %9, %7
+  %.03 = phi i32 [ %.02, %7 ], [ %.02, %9 ]
+  %.1 = phi i32 [ %8, %7 ], [ %10, %9 ]
+  br label %12
+
+12:                                               ; preds = %11
+  %13 = add nsw i32 %.03, 1
+  %14 = icmp slt i32 %13, %1
+  br i1 %14, label %5, label %._crit_edge, !llvm.loop !10
+
+._crit_edge:                                      ; preds = %12
+  %split = phi i32 [ %.1, %12 ]
+  br label %15
+
+15:                                               ; preds = %._crit_edge, %2
+  %.01.lcssa = phi i32 [ %split, %._crit_edge ], [ 0, %2 ]
+  ret i32 %.01.lcssa
+}
+
+attributes #0 = { mustprogress noinline nounwind uwtable "frame-pointer"="all" "min-legal-vector-width"="0" "no-trapping-math"="true" "stack-protector-buffer-size"="8" "target-cpu"="x86-64" "target-features"="+cmov,+cx8,+fxsr,+mmx,+sse,+sse2,+x87" "tune-cpu"="generic" }
+
+!llvm.module.flags = !{!0, !1, !2, !3, !4}
+!llvm.ident = !{!5}
+
+!0 = !{i32 1, !"wchar_size", i32 4}
+!1 = !{i32 8, !"PIC Level", i32 2}
+!2 = !{i32 7, !"PIE Level", i32 2}
+!3 = !{i32 7, !"uwtable", i32 2}
+!4 = !{i32 7, !"frame-pointer", i32 2}
+!5 = !{!"Ubuntu clang version 19.1.7 (++20250114103320+cd708029e0b2-1~exp1~20250114103432.75)"}
+!6 = distinct !{!6, !7}
+!7 = !{!"llvm.loop.mustprogress"}
+!8 = distinct !{!8, !7}
+!9 = distinct !{!9, !7}
+!10 = distinct !{!10, !7}
@@ -103,6 +103,103 @@ define dso_local void @_Z5test4i(i32 noundef %0) #0 {
   ret void
 }
 
+; Function Attrs: mustprogress noinline nounwind uwtable
+define dso_local noundef i32 @_Z5test5ib(i32 noundef %0, i1 noundef zeroext %1) #0 {
+  %3 = zext i1 %1 to i8
+  %4 = mul nsw i32 %0, 3
+  br label %5
+
+5:                                                ; preds = %2, %12
+  %.02 = phi i32 [ 0, %2 ], [ %13, %12 ]
+  %.011 = phi i32 [ 0, %2 ], [ %.1, %12 ]
+  %6 = trunc i8 %3 to i1
+  br i1 %6, label %7, label %9
+
+7:                                                ; preds = %5
+  %8 = add nsw i32 %.011, %4
+  br label %11
+
+9:                                                ; preds = %5
+  %10 = sub nsw i32 %.011, %4
+  br label %11
+
+11:                                               ; preds = %9, %7
+  %.1 = phi i32 [ %8, %7 ], [ %10, %9 ]
+  br label %12
+
+12:                                               ; preds = %11
+  %13 = add nsw i32 %.02, 1
+  %14 = icmp slt i32 %13, 20
+  br i1 %14, label %5, label %15, !llvm.loop !11
+
+15:                                               ; preds = %12
+  %.01.lcssa = phi i32 [ %.1, %12 ]
+  ret i32 %.01.lcssa
+}
+
+; Function Attrs: mustprogress noinline nounwind uwtable
+define dso_local noundef i32 @_Z5test6ii(i32 noundef %0, i32 noundef %1) #0 {
+  br label %3
+
+3:                                                ; preds = %2, %9
+  %.02 = phi i32 [ 0, %2 ], [ %10, %9 ]
+  %.011 = phi i32 [ 0, %2 ], [ %.1, %9 ]
+  %4 = icmp ne i32 %1, 0
+  br i1 %4, label %5, label %8
+
+5:                                                ; preds = %3
+  %6 = sdiv i32 %0, %1
+  %7 = add nsw i32 %.011, %6
+  br label %8
+
+8:                                                ; preds = %5, %3
+  %.1 = phi i32 [ %7, %5 ], [ %.011, %3 ]
+  br label %9
+
+9:                                                ; preds = %8
+  %10 = add nsw i32 %.02, 1
+  %11 = icmp slt i32 %10, 20
+  br i1 %11, label %3, label %12, !llvm.loop !12
+
+12:                                               ; preds = %9
+  %.01.lcssa = phi i32 [ %.1, %9 ]
+  ret i32 %.01.lcssa
+}
+
+; Function Attrs: mustprogress noinline nounwind uwtable
+define dso_local noundef i32 @_Z5test7iib(i32 noundef %0, i32 noundef %1, i1 noundef zeroext %2) #0 {
+  %4 = zext i1 %2 to i8
+  %5 = sdiv i32 %0, %1
+  br label %6
+
+6:                                                ; preds = %3, %13
+  %.02 = phi i32 [ 0, %3 ], [ %14, %13 ]
+  %.011 = phi i32 [ 0, %3 ], [ %.1, %13 ]
+  %7 = trunc i8 %4 to i1
+  br i1 %7, label %8, label %10
+
+8:                                                ; preds = %6
+  %9 = add nsw i32 %.011, %5
+  br label %12
+
+10:                                               ; preds = %6
+  %11 = sub nsw i32 %.011, %5
+  br label %12
+
+12:                                               ; preds = %10, %8
+  %.1 = phi i32 [ %9, %8 ], [ %11, %10 ]
+  br label %13
+
+13:                                               ; preds = %12
+  %14 = add nsw i32 %.02, 1
+  %15 = icmp slt i32 %14, 20
+  br i1 %15, label %6, label %16, !llvm.loop !13
+
+16:                                               ; preds = %13
+  %.01.lcssa = phi i32 [ %.1, %13 ]
+  ret i32 %.01.lcssa
+}
+
 attributes #0 = { mustprogress noinline nounwind uwtable "frame-pointer"="all" "min-legal-vector-width"="0" "no-trapping-math"="true" "stack-protector-buffer-size"="8" "target-cpu"="x86-64" "target-features"="+cmov,+cx8,+fxsr,+mmx,+sse,+sse2,+x87" "tune-cpu"="generic" }
 
 !llvm.module.flags = !{!0, !1, !2, !3, !4}
@@ -119,3 +216,6 @@ attributes #0 = { mustprogress noinline nounwind uwtable "frame-pointer"="all" "
 !8 = distinct !{!8, !7}
 !9 = distinct !{!9, !7}
 !10 = distinct !{!10, !7}
+!11 = distinct !{!11, !7}
+!12 = distinct !{!12, !7}
+!13 = distinct !{!13, !7}
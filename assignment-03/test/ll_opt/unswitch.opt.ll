@@ -0,0 +1,348 @@
+; ModuleID = 'test/bc/unswitch.opt.bc'
+source_filename = "test/cpp/unswitch.cpp"
+target datalayout = "e-m:e-p270:32:32-p271:32:32-p272:64:64-i64:64-i128:128-f80:128-n8:16:32:64-S128"
+target triple = "x86_64-pc-linux-gnu"
+
+; Function Attrs: mustprogress noinline nounwind uwtable
+define dso_local noundef i32 @_Z13invariantModeii(i32 noundef %0, i32 noundef %1) #0 {
+  %3 = icmp slt i32 0, %0
+  br i1 %3, label %.lr.ph, label %12
+
+.lr.ph:                                           ; preds = %2
+  %4 = icmp eq i32 %1, 3
+  br i1 %4, label %.lr.ph.us.true, label %.lr.ph.us.false
+
+.lr.ph.us.true:                                   ; preds = %.lr.ph
+  br label %5
+
+.lr.ph.us.false:                                  ; preds = %.lr.ph
+  br label %13
+
+5:                                                ; preds = %.lr.ph.us.true, %9
+  %.02 = phi i32 [ 0, %.lr.ph.us.true ], [ %10, %9 ]
+  %.011 = phi i32 [ 0, %.lr.ph.us.true ], [ %7, %9 ]
+  br label %6
+
+6:                                                ; preds = %5
+  %7 = add nsw i32 %.011, %.02
+  br label %8
+
+8:                                                ; preds = %6
+  br label %9
+
+9:                                                ; preds = %8
+  %10 = add nsw i32 %.02, 1
+  %11 = icmp slt i32 %10, %0
+  br i1 %11, label %5, label %._crit_edge.loopexit1, !llvm.loop !6
+
+._crit_edge.loopexit:                             ; preds = %17
+  %split.ph = phi i32 [ %15, %17 ]
+  br label %._crit_edge
+
+._crit_edge.loopexit1:                            ; preds = %9
+  %split.ph2 = phi i32 [ %7, %9 ]
+  br label %._crit_edge
+
+._crit_edge:                                      ; preds = %._crit_edge.loopexit1, %._crit_edge.loopexit
+  %split = phi i32 [ %split.ph, %._crit_edge.loopexit ], [ %split.ph2, %._crit_edge.loopexit1 ]
+  br label %12
+
+12:                                               ; preds = %._crit_edge, %2
+  %.01.lcssa = phi i32 [ %split, %._crit_edge ], [ 0, %2 ]
+  ret i32 %.01.lcssa
+
+13:                                               ; preds = %.lr.ph.us.false, %17
+  %.02.us = phi i32 [ 0, %.lr.ph.us.false ], [ %18, %17 ]
+  %.011.us = phi i32 [ 0, %.lr.ph.us.false ], [ %15, %17 ]
+  br label %14
+
+14:                                               ; preds = %13
+  %15 = sub nsw i32 %.011.us, %.02.us
+  br label %16
+
+16:                                               ; preds = %14
+  br label %17
+
+17:                                               ; preds = %16
+  %18 = add nsw i32 %.02.us, 1
+  %19 = icmp slt i32 %18, %0
+  br i1 %19, label %13, label %._crit_edge.loopexit, !llvm.loop !6
+}
+
+; Function Attrs: mustprogress noinline nounwind uwtable
+define dso_local void @_Z11twoSwitchesPiibb(ptr noundef %0, i32 noundef %1, i1 noundef zeroext %2, i1 noundef zeroext %3) #0 {
+  %5 = zext i1 %2 to i8
+  %6 = zext i1 %3 to i8
+  %7 = icmp slt i32 0, %1
+  br i1 %7, label %.lr.ph, label %26
+
+.lr.ph:                                           ; preds = %4
+  %8 = trunc i8 %5 to i1
+  br i1 %8, label %.lr.ph.us.true, label %.lr.ph.us.false
+
+.lr.ph.us.true:                                   ; preds = %.lr.ph
+  %9 = trunc i8 %6 to i1
+  br i1 %9, label %.lr.ph.us.true.us.true, label %.lr.ph.us.true.us.false
+
+.lr.ph.us.false:                                  ; preds = %.lr.ph
+  %10 = trunc i8 %6 to i1
+  br i1 %10, label %.lr.ph.us.false.us.true, label %.lr.ph.us.false.us.false
+
+.lr.ph.us.true.us.true:                           ; preds = %.lr.ph.us.true
+  br label %11
+
+.lr.ph.us.true.us.false:                          ; preds = %.lr.ph.us.true
+  br label %40
+
+11:                                               ; preds = %.lr.ph.us.true.us.true, %23
+  %.011 = phi i32 [ 0, %.lr.ph.us.true.us.true ], [ %24, %23 ]
+  %12 = sext i32 %.011 to i64
+  %13 = getelementptr inbounds i32, ptr %0, i64 %12
+  %14 = load i32, ptr %13, align 4
+  br label %15
+
+15:                                               ; preds = %11
+  %16 = mul nsw i32 %14, 2
+  br label %17
+
+17:                                               ; preds = %15
+  br label %18
+
+18:                                               ; preds = %17
+  %19 = add nsw i32 %16, 7
+  br label %20
+
+20:                                               ; preds = %18
+  %21 = sext i32 %.011 to i64
+  %22 = getelementptr inbounds i32, ptr %0, i64 %21
+  store i32 %19, ptr %22, align 4
+  br label %23
+
+23:                                               ; preds = %20
+  %24 = add nsw i32 %.011, 1
+  %25 = icmp slt i32 %24, %1
+  br i1 %25, label %11, label %._crit_edge.loopexit1.loopexit4, !llvm.loop !8
+
+._crit_edge.loopexit.loopexit:                    ; preds = %61
+  br label %._crit_edge.loopexit
+
+._crit_edge.loopexit.loopexit5:                   ; preds = %37
+  br label %._crit_edge.loopexit
+
+._crit_edge.loopexit:                             ; preds = %._crit_edge.loopexit.loopexit5, %._crit_edge.loopexit.loopexit
+  br label %._crit_edge
+
+._crit_edge.loopexit1.loopexit:                   ; preds = %50
+  br label %._crit_edge.loopexit1
+
+._crit_edge.loopexit1.loopexit4:                  ; preds = %23
+  br label %._crit_edge.loopexit1
+
+._crit_edge.loopexit1:                            ; preds = %._crit_edge.loopexit1.loopexit4, %._crit_edge.loopexit1.loopexit
+  br label %._crit_edge
+
+._crit_edge:                                      ; preds = %._crit_edge.loopexit1, %._crit_edge.loopexit
+  br label %26
+
+26:                                               ; preds = %._crit_edge, %4
+  ret void
+
+.lr.ph.us.false.us.true:                          ; preds = %.lr.ph.us.false
+  br label %27
+
+.lr.ph.us.false.us.false:                         ; preds = %.lr.ph.us.false
+  br label %53
+
+27:                                               ; preds = %.lr.ph.us.false.us.true, %37
+  %.011.us = phi i32 [ 0, %.lr.ph.us.false.us.true ], [ %38, %37 ]
+  %28 = sext i32 %.011.us to i64
+  %29 = getelementptr inbounds i32, ptr %0, i64 %28
+  %30 = load i32, ptr %29, align 4
+  br label %31
+
+31:                                               ; preds = %27
+  br label %32
+
+32:                                               ; preds = %31
+  %33 = add nsw i32 %30, 7
+  br label %34
+
+34:                                               ; preds = %32
+  %35 = sext i32 %.011.us to i64
+  %36 = getelementptr inbounds i32, ptr %0, i64 %35
+  store i32 %33, ptr %36, align 4
+  br label %37
+
+37:                                               ; preds = %34
+  %38 = add nsw i32 %.011.us, 1
+  %39 = icmp slt i32 %38, %1
+  br i1 %39, label %27, label %._crit_edge.loopexit.loopexit5, !llvm.loop !8
+
+40:                                               ; preds = %.lr.ph.us.true.us.false, %50
+  %.011.us2 = phi i32 [ 0, %.lr.ph.us.true.us.false ], [ %51, %50 ]
+  %41 = sext i32 %.011.us2 to i64
+  %42 = getelementptr inbounds i32, ptr %0, i64 %41
+  %43 = load i32, ptr %42, align 4
+  br label %44
+
+44:                                               ; preds = %40
+  %45 = mul nsw i32 %43, 2
+  br label %46
+
+46:                                               ; preds = %44
+  br label %47
+
+47:                                               ; preds = %46
+  %48 = sext i32 %.011.us2 to i64
+  %49 = getelementptr inbounds i32, ptr %0, i64 %48
+  store i32 %45, ptr %49, align 4
+  br label %50
+
+50:                                               ; preds = %47
+  %51 = add nsw i32 %.011.us2, 1
+  %52 = icmp slt i32 %51, %1
+  br i1 %52, label %40, label %._crit_edge.loopexit1.loopexit, !llvm.loop !8
+
+53:                                               ; preds = %.lr.ph.us.false.us.false, %61
+  %.011.us.us = phi i32 [ 0, %.lr.ph.us.false.us.false ], [ %62, %61 ]
+  %54 = sext i32 %.011.us.us to i64
+  %55 = getelementptr inbounds i32, ptr %0, i64 %54
+  %56 = load i32, ptr %55, align 4
+  br label %57
+
+57:                                               ; preds = %53
+  br label %58
+
+58:                                               ; preds = %57
+  %59 = sext i32 %.011.us.us to i64
+  %60 = getelementptr inbounds i32, ptr %0, i64 %59
+  store i32 %56, ptr %60, align 4
+  br label %61
+
+61:                                               ; preds = %58
+  %62 = add nsw i32 %.011.us.us, 1
+  %63 = icmp slt i32 %62, %1
+  br i1 %63, label %53, label %._crit_edge.loopexit.loopexit, !llvm.loop !8
+}
+
+; Function Attrs: mustprogress noinline nounwind uwtable
+define dso_local noundef i32 @_Z11variantCondi(i32 noundef %0) #0 {
+  %2 = icmp slt i32 0, %0
+  br i1 %2, label %.lr.ph, label %12
+
+.lr.ph:                                           ; preds = %1
+  br label %3
+
+3:                                                ; preds = %.lr.ph, %9
+  %.02 = phi i32 [ 0, %.lr.ph ], [ %10, %9 ]
+  %.011 = phi i32 [ 0, %.lr.ph ], [ %.1, %9 ]
+  %4 = srem i32 %.02, 2
+  %5 = icmp eq i32 %4, 0
+  br i1 %5, label %6, label %8
+
+6:                                                ; preds = %3
+  %7 = add nsw i32 %.011, %.02
+  br label %8
+
+8:                                                ; preds = %6, %3
+  %.1 = phi i32 [ %7, %6 ], [ %.011, %3 ]
+  br label %9
+
+9:                                                ; preds = %8
+  %10 = add nsw i32 %.02, 1
+  %11 = icmp slt i32 %10, %0
+  br i1 %11, label %3, label %._crit_edge, !llvm.loop !9
+
+._crit_edge:                                      ; preds = %9
+  %split = phi i32 [ %.1, %9 ]
+  br label %12
+
+12:                                               ; preds = %._crit_edge, %1
+  %.01.lcssa = phi i32 [ %split, %._crit_edge ], [ 0, %1 ]
+  ret i32 %.01.lcssa
+}
+
+; Function Attrs: mustprogress noinline nounwind uwtable
+define dso_local noundef i32 @_Z10frozenFlagPKii(ptr noundef %0, i32 noundef %1) #0 {
+  %3 = load i32, ptr %0, align 4
+  %4 = icmp slt i32 0, %1
+  br i1 %4, label %.lr.ph, label %13
+
+.lr.ph:                                           ; preds = %2
+  %5 = icmp ne i32 %3, 0
+  %.fr = freeze i1 %5
+  br i1 %.fr, label %.lr.ph.us.true, label %.lr.ph.us.false
+
+.lr.ph.us.true:                                   ; preds = %.lr.ph
+  br label %6
+
+.lr.ph.us.false:                                  ; preds = %.lr.ph
+  br label %14
+
+6:                                                ; preds = %.lr.ph.us.true, %10
+  %.02 = phi i32 [ 0, %.lr.ph.us.true ], [ %11, %10 ]
+  %.011 = phi i32 [ 0, %.lr.ph.us.true ], [ %8, %10 ]
+  br label %7
+
+7:                                                ; preds = %6
+  %8 = add nsw i32 %.011, %.02
+  br label %9
+
+9:                                                ; preds = %7
+  br label %10
+
+10:                                               ; preds = %9
+  %11 = add nsw i32 %.02, 1
+  %12 = icmp slt i32 %11, %1
+  br i1 %12, label %6, label %._crit_edge.loopexit1, !llvm.loop !10
+
+._crit_edge.loopexit:                             ; preds = %18
+  %split.ph = phi i32 [ %16, %18 ]
+  br label %._crit_edge
+
+._crit_edge.loopexit1:                            ; preds = %10
+  %split.ph2 = phi i32 [ %8, %10 ]
+  br label %._crit_edge
+
+._crit_edge:                                      ; preds = %._crit_edge.loopexit1, %._crit_edge.loopexit
+  %split = phi i32 [ %split.ph, %._crit_edge.loopexit ], [ %split.ph2, %._crit_edge.loopexit1 ]
+  br label %13
+
+13:                                               ; preds = %._crit_edge, %2
+  %.01.lcssa = phi i32 [ %split, %._crit_edge ], [ 0, %2 ]
+  ret i32 %.01.lcssa
+
+14:                                               ; preds = %.lr.ph.us.false, %18
+  %.02.us = phi i32 [ 0, %.lr.ph.us.false ], [ %19, %18 ]
+  %.011.us = phi i32 [ 0, %.lr.ph.us.false ], [ %16, %18 ]
+  br label %15
+
+15:                                               ; preds = %14
+  %16 = sub nsw i32 %.011.us, %.02.us
+  br label %17
+
+17:                                               ; preds = %15
+  br label %18
+
+18:                                               ; preds = %17
+  %19 = add nsw i32 %.02.us, 1
+  %20 = icmp slt i32 %19, %1
+  br i1 %20, label %14, label %._crit_edge.loopexit, !llvm.loop !10
+}
+
+attributes #0 = { mustprogress noinline nounwind uwtable "frame-pointer"="all" "min-legal-vector-width"="0" "no-trapping-math"="true" "stack-protector-buffer-size"="8" "target-cpu"="x86-64" "target-features"="+cmov,+cx8,+fxsr,+mmx,+sse,+sse2,+x87" "tune-cpu"="generic" }
+
+!llvm.module.flags = !{!0, !1, !2, !3, !4}
+!llvm.ident = !{!5}
+
+!0 = !{i32 1, !"wchar_size", i32 4}
+!1 = !{i32 8, !"PIC Level", i32 2}
+!2 = !{i32 7, !"PIE Level", i32 2}
+!3 = !{i32 7, !"uwtable", i32 2}
+!4 = !{i32 7, !"frame-pointer", i32 2}
+!5 = !{!"Ubuntu clang version 19.1.7 (++20250114103320+cd708029e0b2-1~exp1~20250114103432.75)"}
+!6 = distinct !{!6, !7}
+!7 = !{!"llvm.loop.mustprogress"}
+!8 = distinct !{!8, !7}
+!9 = distinct !{!9, !7}
+!10 = distinct !{!10, !7}
@@ -0,0 +1,108 @@
+#include "LoopDeletion.h"
+
+#include "llvm/ADT/Statistic.h"
+using namespace llvm;
+
+#define DEBUG_TYPE "LoopDeletion-opt"
+
+STATISTIC(NumDeleted, "Loops deleted");
+STATISTIC(NumExitValues, "Values used after a deleted loop replaced by their exit value");
+STATISTIC(NumNotFinite, "Dead loops not deleted: not provably finite");
+STATISTIC(NumNoExitValue, "Dead loops not deleted: an exit value has no closed form");
+
+PreservedAnalyses LoopDeletionOpt::run(Function &F, FunctionAnalysisManager &FAM) {
+  auto &LI = FAM.getResult<LoopAnalysis>(F);
+  auto &DT = FAM.getResult<DominatorTreeAnalysis>(F);
+  auto &SE = FAM.getResult<ScalarEvolutionAnalysis>(F);
+  auto &ORE = FAM.getResult<OptimizationRemarkEmitterAnalysis>(F);
+  bool changed = false;
+
+  // Innermost loops first: deleting them may leave their parents empty.
+  // reverse() does not extend the lifetime of a temporary
+  SmallVector<Loop*, 4> loops = LI.getLoopsInPreorder();
+  for (Loop *L : reverse(loops))
+    changed |= runOnLoop(L, LI, DT, SE, ORE);
+
+  return changed ? PreservedAnalyses::none() : PreservedAnalyses::all();
+}
+
+bool LoopDeletionOpt::runOnLoop(Loop *L, LoopInfo &LI, DominatorTree &DT, ScalarEvolution &SE,
+                                OptimizationRemarkEmitter &ORE) {
+  // The subloops left were not deleted, and may not terminate
+  if (!L->isInnermost()) return false;
+
+  for (BasicBlock *BB : L->blocks())
+    for (Instruction &I : *BB)
+      if (I.mayHaveSideEffects()) return false;
+
+  // Set once the loop is put in LCSSA form, which a missed deletion keeps
+  bool changed = false;
+  auto missed = [&](StringRef name, StringRef reason) {
+    ORE.emit([&] {
+      return OptimizationRemarkMissed(DEBUG_TYPE, name, L->getStartLoc(), L->getHeader())
+             << "dead loop not deleted: " << reason;
+    });
+    return changed;
+  };
+
+  BasicBlock *preheader = L->getLoopPreheader();
+  BasicBlock *exiting = L->getExitingBlock();
+  BasicBlock *exit = L->getUniqueExitBlock();
+  if (!preheader || !exiting || !exit || !L->hasDedicatedExits())
+    return missed("NotSimplified", "no preheader, several exits, or exits shared with other loops");
+
+  // The exit values are read from the LCSSA phis, which LoopFusion-opt does
+  // not keep for the loop it fuses
+  if (!L->isLCSSAForm(DT))
+    changed = formLCSSA(*L, DT, &LI, &SE);
+
+  // Removing a loop that may not terminate changes what the program does
+  if (isa<SCEVCouldNotCompute>(SE.getConstantMaxBackedgeTakenCount(L))) {
+    ++NumNotFinite;
+    return missed("NotFinite", "its trip count cannot be bounded");
+  }
+
+  // The values the loop computes for the code after it, i.e. the LCSSA phis,
+  // in closed form
+  SCEVExpander Rewriter(SE, preheader->getModule()->getDataLayout(), "loopdel");
+  Instruction *insertPt = preheader->getTerminator();
+  SmallVector<std::pair<PHINode*, const SCEV*>, 4> exitValues;
+  for (PHINode &PN : exit->phis()) {
+    auto *I = dyn_cast<Instruction>(PN.getIncomingValueForBlock(exiting));
+    if (!I || !L->contains(I)) continue;
+
+    const SCEV *exitValue = SE.isSCEVable(I->getType()) ? SE.getSCEVAtScope(I, L->getParentLoop())
+                                                         : SE.getCouldNotCompute();
+    if (isa<SCEVCouldNotCompute>(exitValue) || !SE.isLoopInvariant(exitValue, L) ||
+        !Rewriter.isSafeToExpandAt(exitValue, insertPt)) {
+      ++NumNoExitValue;
+      ORE.emit([&] {
+        return OptimizationRemarkMissed(DEBUG_TYPE, "NoExitValue", L->getStartLoc(), L->getHeader())
+               << "dead loop not deleted: no closed form for the exit value of " << ore::NV("Inst", I);
+      });
+      return changed;
+    }
+    exitValues.emplace_back(&PN, exitValue);
+  }
+
+  for (auto &[PN, exitValue] : exitValues) {
+    Value *V = Rewriter.expandCodeFor(exitValue, PN->getType(), insertPt);
+    // Every incoming block is an exiting block: deleteDeadLoop keeps one
+    // incoming value, from the preheader
+    for (unsigned i = 0, e = PN->getNumIncomingValues(); i < e; ++i)
+      PN->setIncomingValue(i, V);
+    ++NumExitValues;
+  }
+
+  ++NumDeleted;
+  ORE.emit([&] {
+    return OptimizationRemark(DEBUG_TYPE, "Deleted", L->getStartLoc(), L->getHeader())
+           << "dead loop deleted, " << ore::NV("ExitValues", unsigned(exitValues.size()))
+           << " values used after it computed in the preheader";
+  });
+
+  // The parent loops may have cached values of the deleted loop
+  SE.forgetTopmostLoop(L);
+  deleteDeadLoop(L, &DT, &SE, &LI);
+  return true;
+}
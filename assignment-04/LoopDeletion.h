@@ -0,0 +1,34 @@
+#ifndef LOOP_DELETION_OPT_H
+#define LOOP_DELETION_OPT_H
+
+#include "llvm/IR/Function.h"
+#include "llvm/IR/IRBuilder.h"
+#include "llvm/IR/Instructions.h"
+#include "llvm/IR/PassManager.h"
+#include "llvm/Passes/PassBuilder.h"
+#include "llvm/Passes/PassPlugin.h"
+
+#include "llvm/Analysis/LoopInfo.h"
+#include "llvm/Analysis/OptimizationRemarkEmitter.h"
+#include "llvm/Analysis/ScalarEvolution.h"
+#include "llvm/IR/Dominators.h"
+#include "llvm/Transforms/Utils/LoopUtils.h"
+#include "llvm/Transforms/Utils/ScalarEvolutionExpander.h"
+
+namespace llvm {
+
+// Deletes the loops left doing nothing, e.g. by LICM-opt or LoopFusion-opt:
+// no side effects, and a trip count SCEV can bound. The values used after the
+// loop are replaced by their exit values, computed in the preheader.
+//
+// Needs the loops in simplified form; a loop not in LCSSA form is put back
+// into it.
+class LoopDeletionOpt : public PassInfoMixin<LoopDeletionOpt> {
+    public:
+        PreservedAnalyses run(Function &F, FunctionAnalysisManager &FAM);
+        bool runOnLoop(Loop *L, LoopInfo &LI, DominatorTree &DT, ScalarEvolution &SE,
+                       OptimizationRemarkEmitter &ORE);
+    };
+}
+
+#endif
@@ -1,11 +1,22 @@
 #include "LoopFusion.h"
+#include "LoopDeletion.h"
+
+#include "llvm/ADT/Statistic.h"
 using namespace llvm;
 
-PreservedAnalyses LoopFusionOpt::run(Function &F, FunctionAnalysisManager &FAM) {
-  outs() << "\nRunning LoopFusionOpt on function: " << F.getName() << "\n";
+#define DEBUG_TYPE "LoopFusion-opt"
+
+STATISTIC(NumFused, "Loops fused");
+STATISTIC(NumNotAdjacent, "Loop pairs not fused: not adjacent");
+STATISTIC(NumDifferentTripCount, "Loop pairs not fused: different trip counts");
+STATISTIC(NumNotControlFlowEquivalent, "Loop pairs not fused: not control flow equivalent");
+STATISTIC(NumNegativeDistance, "Loop pairs not fused: negative dependence distance");
+STATISTIC(NumCold, "Loop pairs not fused: cold");
 
+PreservedAnalyses LoopFusionOpt::run(Function &F, FunctionAnalysisManager &FAM) {
   auto &LI = FAM.getResult<LoopAnalysis>(F);
   bool changed = false;
+  hotness = LoopHotness::get(F, FAM);
 
   const std::vector<Loop*>& topLevelLoops = LI.getTopLevelLoops();
   changed = runOnLoops(F, FAM, topLevelLoops);
@@ -14,6 +25,7 @@ PreservedAnalyses LoopFusionOpt::run(Function &F, FunctionAnalysisManager &FAM)
 }
 
 bool LoopFusionOpt::runOnLoops(Function &F, FunctionAnalysisManager &FAM, const std::vector<Loop*> &Loops) {
+  auto &ORE = FAM.getResult<OptimizationRemarkEmitterAnalysis>(F);
   bool changed = false;
 
   Loop *prev = nullptr;
@@ -21,7 +33,11 @@ bool LoopFusionOpt::runOnLoops(Function &F, FunctionAnalysisManager &FAM, const
     Loop* curr = *rit; 
     
     if (prev && isOptimizable(F, FAM, prev, curr)) {
-        outs() << "\noptimizable loops: " << prev << " " << curr << "\n";
+        ++NumFused;
+        ORE.emit([&] {
+          return OptimizationRemark(DEBUG_TYPE, "Fused", curr->getStartLoc(), curr->getHeader())
+                 << "loop fused into the loop at " << ore::NV("Header", prev->getHeader());
+        });
         prev = fuseLoops(F, FAM, prev, curr);
         changed = true;
     } else {
@@ -169,6 +185,8 @@ Loop* LoopFusionOpt::fuseLoops(Function &F, FunctionAnalysisManager &FAM, Loop *
 }
 
 bool LoopFusionOpt::isOptimizable(Function &F, FunctionAnalysisManager &FAM, Loop *prev, Loop *curr){
+  auto &ORE = FAM.getResult<OptimizationRemarkEmitterAnalysis>(F);
+
   auto isAdjacent = [&]() -> bool {
     auto prevExitBB = prev->isGuarded() ? 
         prev->getExitBlock()->getSingleSuccessor()  
@@ -236,6 +254,7 @@ bool LoopFusionOpt::isOptimizable(Function &F, FunctionAnalysisManager &FAM, Loo
   };
 
   auto hasNotDependencies = [&]() -> bool {
+    TimeTraceScope scope("LoopFusionOpt dependences", [&] { return curr->getHeader()->getName().str(); });
     auto &DI = FAM.getResult<DependenceAnalysis>(F);
     ScalarEvolution &SE = FAM.getResult<ScalarEvolutionAnalysis>(F);
     const DataLayout &DL = F.getParent()->getDataLayout();
@@ -245,8 +264,6 @@ bool LoopFusionOpt::isOptimizable(Function &F, FunctionAnalysisManager &FAM, Loo
           for (auto *BB2 : curr->getBlocks()) {
             for (auto &I2 : *BB2) {
               if (auto Dep = DI.depends(&I, &I2, true)) {
-
-                outs() << "Istruzioniii: " << I << " " << I2 << "\n";
                 Value *Pointer1 = getInstructionPointer(&I);
                 Value *Pointer2 = getInstructionPointer(&I2);
                 const SCEV *Expr1 = SE.getSCEV(Pointer1);
@@ -266,7 +283,11 @@ bool LoopFusionOpt::isOptimizable(Function &F, FunctionAnalysisManager &FAM, Loo
 
                     uint64_t ElemSize = DL.getTypeAllocSize(ElemTy);
                     int64_t ElementOffset = ByteOffset.getSExtValue() / (int64_t)ElemSize;
-                    outs() << "Distanza: " << ElementOffset << "\n";
+                    ORE.emit([&] {
+                      return OptimizationRemarkAnalysis(DEBUG_TYPE, "Dependence", &I2)
+                             << ore::NV("Inst", &I2) << " depends on " << ore::NV("Source", &I)
+                             << " of the previous loop at distance " << ore::NV("Distance", ElementOffset);
+                    });
                     if(ElementOffset < 0) return false;
                   }
                 }
@@ -278,11 +299,31 @@ bool LoopFusionOpt::isOptimizable(Function &F, FunctionAnalysisManager &FAM, Loo
     return true;
   };
 
-  return isAdjacent() && hasSameLoopTripCount() && isControlFlowEq() && hasNotDependencies();
+  auto missed = [&](Statistic &stat, StringRef name, StringRef reason) {
+    ++stat;
+    ORE.emit([&] {
+      return OptimizationRemarkMissed(DEBUG_TYPE, name, curr->getStartLoc(), curr->getHeader())
+             << "loop not fused with the loop at " << ore::NV("Header", prev->getHeader())
+             << ": " << reason;
+    });
+    return false;
+  };
+
+  if (!hotness.isHot(prev) || !hotness.isHot(curr))
+    return missed(NumCold, "ColdLoop", "cold");
+  if (!isAdjacent())
+    return missed(NumNotAdjacent, "NotAdjacent", "not adjacent");
+  if (!hasSameLoopTripCount())
+    return missed(NumDifferentTripCount, "DifferentTripCount", "different or unknown trip counts");
+  if (!isControlFlowEq())
+    return missed(NumNotControlFlowEquivalent, "NotControlFlowEquivalent", "not control flow equivalent");
+  if (!hasNotDependencies())
+    return missed(NumNegativeDistance, "NegativeDistance", "a dependence has a negative distance");
+  return true;
 }
 
 
-PassPluginLibraryInfo getLocalOptPluginInfo() {
+PassPluginLibraryInfo getLoopFusionPluginInfo() {
   return {
     LLVM_PLUGIN_API_VERSION,
     "LoopFusionOpt",
@@ -295,13 +336,20 @@ PassPluginLibraryInfo getLocalOptPluginInfo() {
             FPM.addPass(LoopFusionOpt());
             return true;
           }
+          if (Name == "LoopDeletion-opt") {
+            FPM.addPass(LoopDeletionOpt());
+            return true;
+          }
           return false;
         });
     }
   };
 }
 
+// The unified plugin provides its own entry point
+#ifndef UNIFIED_PLUGIN
 extern "C" LLVM_ATTRIBUTE_WEAK ::llvm::PassPluginLibraryInfo
 llvmGetPassPluginInfo() {
-  return getLocalOptPluginInfo();
+  return getLoopFusionPluginInfo();
 }
+#endif
@@ -16,12 +16,17 @@
 #include "llvm/ADT/SetVector.h"
 #include "llvm/Analysis/LoopInfo.h"
 #include "llvm/Analysis/DependenceAnalysis.h"
+#include "llvm/Analysis/OptimizationRemarkEmitter.h"
 #include "llvm/Analysis/ScalarEvolution.h"
+#include "llvm/Analysis/ScalarEvolutionExpressions.h"
 #include "llvm/Analysis/PostDominators.h"
 #include "llvm/IR/Dominators.h"
+#include "llvm/Support/TimeProfiler.h"
 #include "llvm/Transforms/Utils/Local.h"
 #include "llvm/Analysis/AliasAnalysis.h"
 
+#include "LoopProfile.h"
+
 namespace llvm {
 
 class LoopFusionOpt : public PassInfoMixin<LoopFusionOpt> {
@@ -30,8 +35,13 @@ class LoopFusionOpt : public PassInfoMixin<LoopFusionOpt> {
         bool runOnLoops(Function &F, FunctionAnalysisManager &FAM, const std::vector<Loop*> &Loops);
         bool isOptimizable(Function &F, FunctionAnalysisManager &FAM, Loop *prev, Loop *curr);
         Loop* fuseLoops(Function &F, FunctionAnalysisManager &FAM, Loop *prev, Loop *curr);
-        
+
+    private:
+        LoopHotness hotness;
     };
 }
 
+// Pipeline names of this plugin, also registered by the unified plugin
+llvm::PassPluginLibraryInfo getLoopFusionPluginInfo();
+
 #endif
\ No newline at end of file
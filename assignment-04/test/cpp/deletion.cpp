@@ -0,0 +1,66 @@
+// DELETED: a and b are computed in closed form in the preheader,
+// a = x * (n - 1) and b = y * (n - 1)
+int accumulators(int x, int y, int n) {
+    int a = 0, b = 0;
+
+    for (int i = 1; i < n; i++) {
+        a += x;
+        b += y;
+    }
+
+    return a + b;
+}
+
+// DELETED: t is loop invariant, the loop only counts
+int invariantResult(int x, int y, int n) {
+    int t = 0;
+
+    for (int i = 0; i < n; i++)
+        t = x * y;
+
+    return t;
+}
+
+// DELETED: the inner loop first, then the outer loop left empty. With a
+// variable inner trip count, the guard of the inner loop would leave a phi
+// with no closed form in the outer loop
+int nested(int n) {
+    int s = 0;
+
+    for (int i = 0; i < n; i++)
+        for (int j = 0; j < 4; j++)
+            s += 3;
+
+    return s;
+}
+
+// DELETED: LoopFusion-opt first fuses the two loops, and the fused loop is
+// put back into LCSSA form before it is deleted
+int fused(int x, int y, int n) {
+    int a = 0, b = 0;
+
+    for (int i = 1; i < n; i++)
+        a += x;
+
+    for (int i = 1; i < n; i++)
+        b += y;
+
+    return a + b;
+}
+
+// NOT DELETED: the loop stores to memory
+void stores(int a[], int n) {
+    for (int i = 0; i < n; i++)
+        a[i] = i;
+}
+
+// NOT DELETED: no side effects, but the trip count depends on memory and
+// SCEV cannot bound it
+int length(const char *s) {
+    int i = 0;
+
+    while (s[i])
+        i++;
+
+    return i;
+}
@@ -0,0 +1,193 @@
+; ModuleID = 'test/bc/deletion.bc'
+source_filename = "test/cpp/deletion.cpp"
+target datalayout = "e-m:e-p270:32:32-p271:32:32-p272:64:64-i64:64-i128:128-f80:128-n8:16:32:64-S128"
+target triple = "x86_64-pc-linux-gnu"
+
+; Function Attrs: mustprogress noinline nounwind uwtable
+define dso_local noundef i32 @_Z12accumulatorsiii(i32 noundef %0, i32 noundef %1, i32 noundef %2) #0 {
+  br label %4
+
+4:                                                ; preds = %9, %3
+  %.02 = phi i32 [ 0, %3 ], [ %7, %9 ]
+  %.01 = phi i32 [ 0, %3 ], [ %8, %9 ]
+  %.0 = phi i32 [ 1, %3 ], [ %10, %9 ]
+  %5 = icmp slt i32 %.0, %2
+  br i1 %5, label %6, label %11
+
+6:                                                ; preds = %4
+  %7 = add nsw i32 %.02, %0
+  %8 = add nsw i32 %.01, %1
+  br label %9
+
+9:                                                ; preds = %6
+  %10 = add nsw i32 %.0, 1
+  br label %4, !llvm.loop !6
+
+11:                                               ; preds = %4
+  %12 = add nsw i32 %.02, %.01
+  ret i32 %12
+}
+
+; Function Attrs: mustprogress noinline nounwind uwtable
+define dso_local noundef i32 @_Z15invariantResultiii(i32 noundef %0, i32 noundef %1, i32 noundef %2) #0 {
+  br label %4
+
+4:                                                ; preds = %8, %3
+  %.01 = phi i32 [ 0, %3 ], [ %7, %8 ]
+  %.0 = phi i32 [ 0, %3 ], [ %9, %8 ]
+  %5 = icmp slt i32 %.0, %2
+  br i1 %5, label %6, label %10
+
+6:                                                ; preds = %4
+  %7 = mul nsw i32 %0, %1
+  br label %8
+
+8:                                                ; preds = %6
+  %9 = add nsw i32 %.0, 1
+  br label %4, !llvm.loop !8
+
+10:                                               ; preds = %4
+  ret i32 %.01
+}
+
+; Function Attrs: mustprogress noinline nounwind uwtable
+define dso_local noundef i32 @_Z6nestedi(i32 noundef %0) #0 {
+  br label %2
+
+2:                                                ; preds = %12, %1
+  %.01 = phi i32 [ 0, %1 ], [ %.1, %12 ]
+  %.0 = phi i32 [ 0, %1 ], [ %13, %12 ]
+  %3 = icmp slt i32 %.0, %0
+  br i1 %3, label %4, label %14
+
+4:                                                ; preds = %2
+  br label %5
+
+5:                                                ; preds = %9, %4
+  %.1 = phi i32 [ %.01, %4 ], [ %8, %9 ]
+  %.02 = phi i32 [ 0, %4 ], [ %10, %9 ]
+  %6 = icmp slt i32 %.02, 4
+  br i1 %6, label %7, label %11
+
+7:                                                ; preds = %5
+  %8 = add nsw i32 %.1, 3
+  br label %9
+
+9:                                                ; preds = %7
+  %10 = add nsw i32 %.02, 1
+  br label %5, !llvm.loop !9
+
+11:                                               ; preds = %5
+  br label %12
+
+12:                                               ; preds = %11
+  %13 = add nsw i32 %.0, 1
+  br label %2, !llvm.loop !10
+
+14:                                               ; preds = %2
+  ret i32 %.01
+}
+
+; Function Attrs: mustprogress noinline nounwind uwtable
+define dso_local noundef i32 @_Z5fusediii(i32 noundef %0, i32 noundef %1, i32 noundef %2) #0 {
+  br label %4
+
+4:                                                ; preds = %8, %3
+  %.03 = phi i32 [ 0, %3 ], [ %7, %8 ]
+  %.01 = phi i32 [ 1, %3 ], [ %9, %8 ]
+  %5 = icmp slt i32 %.01, %2
+  br i1 %5, label %6, label %10
+
+6:                                                ; preds = %4
+  %7 = add nsw i32 %.03, %0
+  br label %8
+
+8:                                                ; preds = %6
+  %9 = add nsw i32 %.01, 1
+  br label %4, !llvm.loop !11
+
+10:                                               ; preds = %4
+  br label %11
+
+11:                                               ; preds = %15, %10
+  %.02 = phi i32 [ 0, %10 ], [ %14, %15 ]
+  %.0 = phi i32 [ 1, %10 ], [ %16, %15 ]
+  %12 = icmp slt i32 %.0, %2
+  br i1 %12, label %13, label %17
+
+13:                                               ; preds = %11
+  %14 = add nsw i32 %.02, %1
+  br label %15
+
+15:                                               ; preds = %13
+  %16 = add nsw i32 %.0, 1
+  br label %11, !llvm.loop !12
+
+17:                                               ; preds = %11
+  %18 = add nsw i32 %.03, %.02
+  ret i32 %18
+}
+
+; Function Attrs: mustprogress noinline nounwind uwtable
+define dso_local void @_Z6storesPii(ptr noundef %0, i32 noundef %1) #0 {
+  br label %3
+
+3:                                                ; preds = %8, %2
+  %.0 = phi i32 [ 0, %2 ], [ %9, %8 ]
+  %4 = icmp slt i32 %.0, %1
+  br i1 %4, label %5, label %10
+
+5:                                                ; preds = %3
+  %6 = sext i32 %.0 to i64
+  %7 = getelementptr inbounds i32, ptr %0, i64 %6
+  store i32 %.0, ptr %7, align 4
+  br label %8
+
+8:                                                ; preds = %5
+  %9 = add nsw i32 %.0, 1
+  br label %3, !llvm.loop !13
+
+10:                                               ; preds = %3
+  ret void
+}
+
+; Function Attrs: mustprogress noinline nounwind uwtable
+define dso_local noundef i32 @_Z6lengthPKc(ptr noundef %0) #0 {
+  br label %2
+
+2:                                                ; preds = %7, %1
+  %.0 = phi i32 [ 0, %1 ], [ %8, %7 ]
+  %3 = sext i32 %.0 to i64
+  %4 = getelementptr inbounds i8, ptr %0, i64 %3
+  %5 = load i8, ptr %4, align 1
+  %6 = icmp ne i8 %5, 0
+  br i1 %6, label %7, label %9
+
+7:                                                ; preds = %2
+  %8 = add nsw i32 %.0, 1
+  br label %2, !llvm.loop !14
+
+9:                                                ; preds = %2
+  ret i32 %.0
+}
+
+attributes #0 = { mustprogress noinline nounwind uwtable "frame-pointer"="all" "min-legal-vector-width"="0" "no-trapping-math"="true" "stack-protector-buffer-size"="8" "target-cpu"="x86-64" "target-features"="+cmov,+cx8,+fxsr,+mmx,+sse,+sse2,+x87" "tune-cpu"="generic" }
+
+!llvm.module.flags = !{!0, !1, !2, !3, !4}
+!llvm.ident = !{!5}
+
+!0 = !{i32 1, !"wchar_size", i32 4}
+!1 = !{i32 8, !"PIC Level", i32 2}
+!2 = !{i32 7, !"PIE Level", i32 2}
+!3 = !{i32 7, !"uwtable", i32 2}
+!4 = !{i32 7, !"frame-pointer", i32 2}
+!5 = !{!"Ubuntu clang version 19.1.7 (++20250114103320+cd708029e0b2-1~exp1~20250114103432.75)"}
+!6 = distinct !{!6, !7}
+!7 = !{!"llvm.loop.mustprogress"}
+!8 = distinct !{!8, !7}
+!9 = distinct !{!9, !7}
+!10 = distinct !{!10, !7}
+!11 = distinct !{!11, !7}
+!12 = distinct !{!12, !7}
+!13 = distinct !{!13, !7}
+!14 = distinct !{!14, !7}
@@ -0,0 +1,224 @@
+; ModuleID = 'test/bc/deletion.pre.bc'
+source_filename = "test/cpp/deletion.cpp"
+target datalayout = "e-m:e-p270:32:32-p271:32:32-p272:64:64-i64:64-i128:128-f80:128-n8:16:32:64-S128"
+target triple = "x86_64-pc-linux-gnu"
+
+; Function Attrs: mustprogress noinline nounwind uwtable
+define dso_local noundef i32 @_Z12accumulatorsiii(i32 noundef %0, i32 noundef %1, i32 noundef %2) #0 {
+  %4 = icmp slt i32 1, %2
+  br i1 %4, label %.lr.ph, label %11
+
+.lr.ph:                                           ; preds = %3
+  br label %5
+
+5:                                                ; preds = %.lr.ph, %8
+  %.03 = phi i32 [ 1, %.lr.ph ], [ %9, %8 ]
+  %.012 = phi i32 [ 0, %.lr.ph ], [ %7, %8 ]
+  %.021 = phi i32 [ 0, %.lr.ph ], [ %6, %8 ]
+  %6 = add nsw i32 %.021, %0
+  %7 = add nsw i32 %.012, %1
+  br label %8
+
+8:                                                ; preds = %5
+  %9 = add nsw i32 %.03, 1
+  %10 = icmp slt i32 %9, %2
+  br i1 %10, label %5, label %._crit_edge, !llvm.loop !6
+
+._crit_edge:                                      ; preds = %8
+  %split = phi i32 [ %6, %8 ]
+  %split4 = phi i32 [ %7, %8 ]
+  br label %11
+
+11:                                               ; preds = %._crit_edge, %3
+  %.02.lcssa = phi i32 [ %split, %._crit_edge ], [ 0, %3 ]
+  %.01.lcssa = phi i32 [ %split4, %._crit_edge ], [ 0, %3 ]
+  %12 = add nsw i32 %.02.lcssa, %.01.lcssa
+  ret i32 %12
+}
+
+; Function Attrs: mustprogress noinline nounwind uwtable
+define dso_local noundef i32 @_Z15invariantResultiii(i32 noundef %0, i32 noundef %1, i32 noundef %2) #0 {
+  %4 = icmp slt i32 0, %2
+  br i1 %4, label %.lr.ph, label %10
+
+.lr.ph:                                           ; preds = %3
+  br label %5
+
+5:                                                ; preds = %.lr.ph, %7
+  %.02 = phi i32 [ 0, %.lr.ph ], [ %8, %7 ]
+  %6 = mul nsw i32 %0, %1
+  br label %7
+
+7:                                                ; preds = %5
+  %8 = add nsw i32 %.02, 1
+  %9 = icmp slt i32 %8, %2
+  br i1 %9, label %5, label %._crit_edge, !llvm.loop !8
+
+._crit_edge:                                      ; preds = %7
+  %split = phi i32 [ %6, %7 ]
+  br label %10
+
+10:                                               ; preds = %._crit_edge, %3
+  %.01.lcssa = phi i32 [ %split, %._crit_edge ], [ 0, %3 ]
+  ret i32 %.01.lcssa
+}
+
+; Function Attrs: mustprogress noinline nounwind uwtable
+define dso_local noundef i32 @_Z6nestedi(i32 noundef %0) #0 {
+  %2 = icmp slt i32 0, %0
+  br i1 %2, label %.lr.ph, label %13
+
+.lr.ph:                                           ; preds = %1
+  br label %3
+
+3:                                                ; preds = %.lr.ph, %10
+  %.04 = phi i32 [ 0, %.lr.ph ], [ %11, %10 ]
+  %.013 = phi i32 [ 0, %.lr.ph ], [ %.1.lcssa, %10 ]
+  br label %4
+
+4:                                                ; preds = %3, %6
+  %.022 = phi i32 [ 0, %3 ], [ %7, %6 ]
+  %.11 = phi i32 [ %.013, %3 ], [ %5, %6 ]
+  %5 = add nsw i32 %.11, 3
+  br label %6
+
+6:                                                ; preds = %4
+  %7 = add nsw i32 %.022, 1
+  %8 = icmp slt i32 %7, 4
+  br i1 %8, label %4, label %9, !llvm.loop !9
+
+9:                                                ; preds = %6
+  %.1.lcssa = phi i32 [ %5, %6 ]
+  br label %10
+
+10:                                               ; preds = %9
+  %11 = add nsw i32 %.04, 1
+  %12 = icmp slt i32 %11, %0
+  br i1 %12, label %3, label %._crit_edge, !llvm.loop !10
+
+._crit_edge:                                      ; preds = %10
+  %split = phi i32 [ %.1.lcssa, %10 ]
+  br label %13
+
+13:                                               ; preds = %._crit_edge, %1
+  %.01.lcssa = phi i32 [ %split, %._crit_edge ], [ 0, %1 ]
+  ret i32 %.01.lcssa
+}
+
+; Function Attrs: mustprogress noinline nounwind uwtable
+define dso_local noundef i32 @_Z5fusediii(i32 noundef %0, i32 noundef %1, i32 noundef %2) #0 {
+  %4 = icmp slt i32 1, %2
+  br i1 %4, label %.lr.ph, label %10
+
+.lr.ph:                                           ; preds = %3
+  br label %5
+
+5:                                                ; preds = %.lr.ph, %7
+  %.012 = phi i32 [ 1, %.lr.ph ], [ %8, %7 ]
+  %.031 = phi i32 [ 0, %.lr.ph ], [ %6, %7 ]
+  %6 = add nsw i32 %.031, %0
+  br label %7
+
+7:                                                ; preds = %5
+  %8 = add nsw i32 %.012, 1
+  %9 = icmp slt i32 %8, %2
+  br i1 %9, label %5, label %._crit_edge, !llvm.loop !11
+
+._crit_edge:                                      ; preds = %7
+  %split = phi i32 [ %6, %7 ]
+  br label %10
+
+10:                                               ; preds = %._crit_edge, %3
+  %.03.lcssa = phi i32 [ %split, %._crit_edge ], [ 0, %3 ]
+  %11 = icmp slt i32 1, %2
+  br i1 %11, label %.lr.ph6, label %17
+
+.lr.ph6:                                          ; preds = %10
+  br label %12
+
+12:                                               ; preds = %.lr.ph6, %14
+  %.04 = phi i32 [ 1, %.lr.ph6 ], [ %15, %14 ]
+  %.023 = phi i32 [ 0, %.lr.ph6 ], [ %13, %14 ]
+  %13 = add nsw i32 %.023, %1
+  br label %14
+
+14:                                               ; preds = %12
+  %15 = add nsw i32 %.04, 1
+  %16 = icmp slt i32 %15, %2
+  br i1 %16, label %12, label %._crit_edge7, !llvm.loop !12
+
+._crit_edge7:                                     ; preds = %14
+  %split8 = phi i32 [ %13, %14 ]
+  br label %17
+
+17:                                               ; preds = %._crit_edge7, %10
+  %.02.lcssa = phi i32 [ %split8, %._crit_edge7 ], [ 0, %10 ]
+  %18 = add nsw i32 %.03.lcssa, %.02.lcssa
+  ret i32 %18
+}
+
+; Function Attrs: mustprogress noinline nounwind uwtable
+define dso_local void @_Z6storesPii(ptr noundef %0, i32 noundef %1) #0 {
+  %3 = icmp slt i32 0, %1
+  br i1 %3, label %.lr.ph, label %10
+
+.lr.ph:                                           ; preds = %2
+  br label %4
+
+4:                                                ; preds = %.lr.ph, %7
+  %.01 = phi i32 [ 0, %.lr.ph ], [ %8, %7 ]
+  %5 = sext i32 %.01 to i64
+  %6 = getelementptr inbounds i32, ptr %0, i64 %5
+  store i32 %.01, ptr %6, align 4
+  br label %7
+
+7:                                                ; preds = %4
+  %8 = add nsw i32 %.01, 1
+  %9 = icmp slt i32 %8, %1
+  br i1 %9, label %4, label %._crit_edge, !llvm.loop !13
+
+._crit_edge:                                      ; preds = %7
+  br label %10
+
+10:                                               ; preds = %._crit_edge, %2
+  ret void
+}
+
+; Function Attrs: mustprogress noinline nounwind uwtable
+define dso_local noundef i32 @_Z6lengthPKc(ptr noundef %0) #0 {
+  br label %2
+
+2:                                                ; preds = %2, %1
+  %.0 = phi i32 [ 0, %1 ], [ %7, %2 ]
+  %3 = sext i32 %.0 to i64
+  %4 = getelementptr inbounds i8, ptr %0, i64 %3
+  %5 = load i8, ptr %4, align 1
+  %6 = icmp ne i8 %5, 0
+  %7 = add nsw i32 %.0, 1
+  br i1 %6, label %2, label %8, !llvm.loop !14
+
+8:                                                ; preds = %2
+  %.0.lcssa = phi i32 [ %.0, %2 ]
+  ret i32 %.0.lcssa
+}
+
+attributes #0 = { mustprogress noinline nounwind uwtable "frame-pointer"="all" "min-legal-vector-width"="0" "no-trapping-math"="true" "stack-protector-buffer-size"="8" "target-cpu"="x86-64" "target-features"="+cmov,+cx8,+fxsr,+mmx,+sse,+sse2,+x87" "tune-cpu"="generic" }
+
+!llvm.module.flags = !{!0, !1, !2, !3, !4}
+!llvm.ident = !{!5}
+
+!0 = !{i32 1, !"wchar_size", i32 4}
+!1 = !{i32 8, !"PIC Level", i32 2}
+!2 = !{i32 7, !"PIE Level", i32 2}
+!3 = !{i32 7, !"uwtable", i32 2}
+!4 = !{i32 7, !"frame-pointer", i32 2}
+!5 = !{!"Ubuntu clang version 19.1.7 (++20250114103320+cd708029e0b2-1~exp1~20250114103432.75)"}
+!6 = distinct !{!6, !7}
+!7 = !{!"llvm.loop.mustprogress"}
+!8 = distinct !{!8, !7}
+!9 = distinct !{!9, !7}
+!10 = distinct !{!10, !7}
+!11 = distinct !{!11, !7}
+!12 = distinct !{!12, !7}
+!13 = distinct !{!13, !7}
+!14 = distinct !{!14, !7}
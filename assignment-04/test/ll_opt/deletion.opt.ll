@@ -0,0 +1,146 @@
+; ModuleID = 'test/bc/deletion.opt.bc'
+source_filename = "test/cpp/deletion.cpp"
+target datalayout = "e-m:e-p270:32:32-p271:32:32-p272:64:64-i64:64-i128:128-f80:128-n8:16:32:64-S128"
+target triple = "x86_64-pc-linux-gnu"
+
+; Function Attrs: mustprogress noinline nounwind uwtable
+define dso_local noundef i32 @_Z12accumulatorsiii(i32 noundef %0, i32 noundef %1, i32 noundef %2) #0 {
+  %4 = icmp slt i32 1, %2
+  br i1 %4, label %.lr.ph, label %8
+
+.lr.ph:                                           ; preds = %3
+  %5 = add i32 %2, -1
+  %6 = mul i32 %0, %5
+  %7 = mul i32 %1, %5
+  br label %._crit_edge
+
+._crit_edge:                                      ; preds = %.lr.ph
+  %split = phi i32 [ %6, %.lr.ph ]
+  %split4 = phi i32 [ %7, %.lr.ph ]
+  br label %8
+
+8:                                                ; preds = %._crit_edge, %3
+  %.02.lcssa = phi i32 [ %split, %._crit_edge ], [ 0, %3 ]
+  %.01.lcssa = phi i32 [ %split4, %._crit_edge ], [ 0, %3 ]
+  %9 = add nsw i32 %.02.lcssa, %.01.lcssa
+  ret i32 %9
+}
+
+; Function Attrs: mustprogress noinline nounwind uwtable
+define dso_local noundef i32 @_Z15invariantResultiii(i32 noundef %0, i32 noundef %1, i32 noundef %2) #0 {
+  %4 = icmp slt i32 0, %2
+  br i1 %4, label %.lr.ph, label %6
+
+.lr.ph:                                           ; preds = %3
+  %5 = mul i32 %1, %0
+  br label %._crit_edge
+
+._crit_edge:                                      ; preds = %.lr.ph
+  %split = phi i32 [ %5, %.lr.ph ]
+  br label %6
+
+6:                                                ; preds = %._crit_edge, %3
+  %.01.lcssa = phi i32 [ %split, %._crit_edge ], [ 0, %3 ]
+  ret i32 %.01.lcssa
+}
+
+; Function Attrs: mustprogress noinline nounwind uwtable
+define dso_local noundef i32 @_Z6nestedi(i32 noundef %0) #0 {
+  %2 = icmp slt i32 0, %0
+  br i1 %2, label %.lr.ph, label %4
+
+.lr.ph:                                           ; preds = %1
+  %3 = mul i32 %0, 12
+  br label %._crit_edge
+
+._crit_edge:                                      ; preds = %.lr.ph
+  %split = phi i32 [ %3, %.lr.ph ]
+  br label %4
+
+4:                                                ; preds = %._crit_edge, %1
+  %.01.lcssa = phi i32 [ %split, %._crit_edge ], [ 0, %1 ]
+  ret i32 %.01.lcssa
+}
+
+; Function Attrs: mustprogress noinline nounwind uwtable
+define dso_local noundef i32 @_Z5fusediii(i32 noundef %0, i32 noundef %1, i32 noundef %2) #0 {
+  %4 = icmp slt i32 1, %2
+  br i1 %4, label %.lr.ph, label %8
+
+.lr.ph:                                           ; preds = %3
+  %5 = add i32 %2, -1
+  %6 = mul i32 %1, %5
+  %7 = mul i32 %0, %5
+  br label %._crit_edge7
+
+._crit_edge7:                                     ; preds = %.lr.ph
+  %split8 = phi i32 [ %6, %.lr.ph ]
+  %split = phi i32 [ %7, %.lr.ph ]
+  br label %8
+
+8:                                                ; preds = %3, %._crit_edge7
+  %.02.lcssa = phi i32 [ %split8, %._crit_edge7 ], [ 0, %3 ]
+  %.03.lcssa = phi i32 [ %split, %._crit_edge7 ], [ 0, %3 ]
+  %9 = add nsw i32 %.03.lcssa, %.02.lcssa
+  ret i32 %9
+}
+
+; Function Attrs: mustprogress noinline nounwind uwtable
+define dso_local void @_Z6storesPii(ptr noundef %0, i32 noundef %1) #0 {
+  %3 = icmp slt i32 0, %1
+  br i1 %3, label %.lr.ph, label %10
+
+.lr.ph:                                           ; preds = %2
+  br label %4
+
+4:                                                ; preds = %.lr.ph, %7
+  %.01 = phi i32 [ 0, %.lr.ph ], [ %8, %7 ]
+  %5 = sext i32 %.01 to i64
+  %6 = getelementptr inbounds i32, ptr %0, i64 %5
+  store i32 %.01, ptr %6, align 4
+  br label %7
+
+7:                                                ; preds = %4
+  %8 = add nsw i32 %.01, 1
+  %9 = icmp slt i32 %8, %1
+  br i1 %9, label %4, label %._crit_edge, !llvm.loop !6
+
+._crit_edge:                                      ; preds = %7
+  br label %10
+
+10:                                               ; preds = %._crit_edge, %2
+  ret void
+}
+
+; Function Attrs: mustprogress noinline nounwind uwtable
+define dso_local noundef i32 @_Z6lengthPKc(ptr noundef %0) #0 {
+  br label %2
+
+2:                                                ; preds = %2, %1
+  %.0 = phi i32 [ 0, %1 ], [ %7, %2 ]
+  %3 = sext i32 %.0 to i64
+  %4 = getelementptr inbounds i8, ptr %0, i64 %3
+  %5 = load i8, ptr %4, align 1
+  %6 = icmp ne i8 %5, 0
+  %7 = add nsw i32 %.0, 1
+  br i1 %6, label %2, label %8, !llvm.loop !8
+
+8:                                                ; preds = %2
+  %.0.lcssa = phi i32 [ %.0, %2 ]
+  ret i32 %.0.lcssa
+}
+
+attributes #0 = { mustprogress noinline nounwind uwtable "frame-pointer"="all" "min-legal-vector-width"="0" "no-trapping-math"="true" "stack-protector-buffer-size"="8" "target-cpu"="x86-64" "target-features"="+cmov,+cx8,+fxsr,+mmx,+sse,+sse2,+x87" "tune-cpu"="generic" }
+
+!llvm.module.flags = !{!0, !1, !2, !3, !4}
+!llvm.ident = !{!5}
+
+!0 = !{i32 1, !"wchar_size", i32 4}
+!1 = !{i32 8, !"PIC Level", i32 2}
+!2 = !{i32 7, !"PIE Level", i32 2}
+!3 = !{i32 7, !"uwtable", i32 2}
+!4 = !{i32 7, !"frame-pointer", i32 2}
+!5 = !{!"Ubuntu clang version 19.1.7 (++20250114103320+cd708029e0b2-1~exp1~20250114103432.75)"}
+!6 = distinct !{!6, !7}
+!7 = !{!"llvm.loop.mustprogress"}
+!8 = distinct !{!8, !7}
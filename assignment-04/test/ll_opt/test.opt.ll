@@ -6,105 +6,55 @@ target triple = "x86_64-pc-linux-gnu"
 ; Function Attrs: mustprogress noinline nounwind uwtable
 define dso_local noundef i32 @_Z11bothGuardediii(i32 noundef %0, i32 noundef %1, i32 noundef %2) #0 {
   %4 = icmp slt i32 1, %2
-  br i1 %4, label %.lr.ph, label %12
+  br i1 %4, label %.lr.ph, label %8
 
 .lr.ph:                                           ; preds = %3
-  br label %5
-
-5:                                                ; preds = %.lr.ph, %9
-  %.012 = phi i32 [ 1, %.lr.ph ], [ %10, %9 ]
-  %.031 = phi i32 [ 0, %.lr.ph ], [ %6, %9 ]
-  %.023 = phi i32 [ 0, %.lr.ph ], [ %8, %9 ]
-  %6 = add nsw i32 %.031, %0
-  br label %7
-
-7:                                                ; preds = %5
-  %8 = add nsw i32 %.023, %1
-  br label %9
-
-9:                                                ; preds = %7
-  %10 = add nsw i32 %.012, 1
-  %11 = icmp slt i32 %10, %2
-  br i1 %11, label %5, label %._crit_edge7, !llvm.loop !6
-
-._crit_edge7:                                     ; preds = %9
-  %split8 = phi i32 [ %8, %9 ]
-  %split = phi i32 [ %6, %9 ]
-  br label %12
+  %5 = add i32 %2, -1
+  %6 = mul i32 %1, %5
+  %7 = mul i32 %0, %5
+  br label %._crit_edge7
+
+._crit_edge7:                                     ; preds = %.lr.ph
+  %split8 = phi i32 [ %6, %.lr.ph ]
+  %split = phi i32 [ %7, %.lr.ph ]
+  br label %8
 
-12:                                               ; preds = %3, %._crit_edge7
+8:                                                ; preds = %3, %._crit_edge7
   %.02.lcssa = phi i32 [ %split8, %._crit_edge7 ], [ 0, %3 ]
   %.03.lcssa = phi i32 [ %split, %._crit_edge7 ], [ 0, %3 ]
-  %13 = add nsw i32 %.03.lcssa, %.02.lcssa
-  ret i32 %13
+  %9 = add nsw i32 %.03.lcssa, %.02.lcssa
+  ret i32 %9
 }
 
 ; Function Attrs: mustprogress noinline nounwind uwtable
 define dso_local noundef i32 @_Z14BothNotGuardedv() #0 {
   br label %1
 
-1:                                                ; preds = %0, %10
-  %.06 = phi i32 [ 0, %0 ], [ %8, %10 ]
-  %.013 = phi i32 [ 0, %0 ], [ %9, %10 ]
-  %.032 = phi i32 [ 0, %0 ], [ %5, %10 ]
-  %.041 = phi i32 [ 1, %0 ], [ %11, %10 ]
-  %2 = add nsw i32 %.06, 1
-  %3 = add nsw i32 %.013, 2
-  %4 = add nsw i32 %3, 3
-  %5 = add nsw i32 %.032, 4
-  br label %6
-
-6:                                                ; preds = %1
-  %7 = add nsw i32 %2, 10
-  %8 = add nsw i32 %7, 20
-  %9 = add nsw i32 %4, 30
-  br label %10
-
-10:                                               ; preds = %6
-  %11 = add nsw i32 %.041, 1
-  %12 = icmp slt i32 %11, 10
-  br i1 %12, label %1, label %13, !llvm.loop !8
-
-13:                                               ; preds = %10
-  %.12.lcssa = phi i32 [ %9, %10 ]
-  %.1.lcssa = phi i32 [ %8, %10 ]
-  %.03.lcssa = phi i32 [ %5, %10 ]
-  %14 = add nsw i32 %.1.lcssa, %.12.lcssa
-  %15 = add nsw i32 %14, %.03.lcssa
-  ret i32 %15
+1:                                                ; preds = %0
+  %.12.lcssa = phi i32 [ 315, %0 ]
+  %.1.lcssa = phi i32 [ 279, %0 ]
+  %.03.lcssa = phi i32 [ 36, %0 ]
+  %2 = add nsw i32 %.1.lcssa, %.12.lcssa
+  %3 = add nsw i32 %2, %.03.lcssa
+  ret i32 %3
 }
 
 ; Function Attrs: mustprogress noinline nounwind uwtable
 define dso_local noundef i32 @_Z12guardedWhileiii(i32 noundef %0, i32 noundef %1, i32 noundef %2) #0 {
   %4 = icmp sgt i32 %0, 0
-  br i1 %4, label %5, label %15
+  br i1 %4, label %5, label %9
 
 5:                                                ; preds = %3
-  br label %6
-
-6:                                                ; preds = %12, %5
-  %.01 = phi i32 [ %1, %5 ], [ %7, %12 ]
-  %.0 = phi i32 [ 0, %5 ], [ %8, %12 ]
-  %.02 = phi i32 [ %2, %5 ], [ %10, %12 ]
-  %7 = add nsw i32 %.01, 5
-  %8 = add nsw i32 %.0, 1
-  br label %9
-
-9:                                                ; preds = %6
-  %10 = add nsw i32 %.02, 6
-  %11 = add nsw i32 %.0, 1
-  br label %12
-
-12:                                               ; preds = %9
-  %13 = icmp slt i32 %8, %0
-  br i1 %13, label %6, label %14, !llvm.loop !9
+  %6 = mul i32 %0, 6
+  %7 = add i32 %2, %6
+  br label %8
 
-14:                                               ; preds = %12
-  %.lcssa = phi i32 [ %10, %12 ]
-  br label %15
+8:                                                ; preds = %5
+  %.lcssa = phi i32 [ %7, %5 ]
+  br label %9
 
-15:                                               ; preds = %3, %14
-  %.13 = phi i32 [ %.lcssa, %14 ], [ %2, %3 ]
+9:                                                ; preds = %3, %8
+  %.13 = phi i32 [ %.lcssa, %8 ], [ %2, %3 ]
   ret i32 %.13
 }
 
@@ -133,7 +83,7 @@ define dso_local void @_Z5noDepPiS_i(ptr noundef %0, ptr noundef %1, i32 noundef
 12:                                               ; preds = %9
   %13 = add nsw i32 %.011, 1
   %14 = icmp slt i32 %13, %2
-  br i1 %14, label %5, label %._crit_edge5, !llvm.loop !10
+  br i1 %14, label %5, label %._crit_edge5, !llvm.loop !6
 
 ._crit_edge5:                                     ; preds = %12
   br label %15
@@ -160,7 +110,7 @@ define dso_local void @_Z3DepPiS_i(ptr noundef %0, ptr noundef %1, i32 noundef %
 8:                                                ; preds = %5
   %9 = add nsw i32 %.011, 1
   %10 = icmp slt i32 %9, %2
-  br i1 %10, label %5, label %._crit_edge, !llvm.loop !11
+  br i1 %10, label %5, label %._crit_edge, !llvm.loop !8
 
 ._crit_edge:                                      ; preds = %8
   br label %11
@@ -187,7 +137,7 @@ define dso_local void @_Z3DepPiS_i(ptr noundef %0, ptr noundef %1, i32 noundef %
 21:                                               ; preds = %13
   %22 = add nsw i32 %.02, 1
   %23 = icmp slt i32 %22, %2
-  br i1 %23, label %13, label %._crit_edge5, !llvm.loop !12
+  br i1 %23, label %13, label %._crit_edge5, !llvm.loop !9
 
 ._crit_edge5:                                     ; preds = %21
   br label %24
@@ -211,6 +161,3 @@ attributes #0 = { mustprogress noinline nounwind uwtable "frame-pointer"="all" "
 !7 = !{!"llvm.loop.mustprogress"}
 !8 = distinct !{!8, !7}
 !9 = distinct !{!9, !7}
-!10 = distinct !{!10, !7}
-!11 = distinct !{!11, !7}
-!12 = distinct !{!12, !7}
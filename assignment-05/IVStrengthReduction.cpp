@@ -0,0 +1,319 @@
+#include "IVStrengthReduction.h"
+
+#include "llvm/ADT/Statistic.h"
+using namespace llvm;
+
+#define DEBUG_TYPE "IVSR-opt"
+
+STATISTIC(NumReduced, "Expressions replaced by an induction variable");
+STATISTIC(NumNewIVs, "Induction variables added");
+STATISTIC(NumRedundantIVs, "Redundant induction variables removed");
+STATISTIC(NumEliminatedCounters, "Loop counters replaced in the exit test");
+
+// Upper bound on the induction variables added to a single loop, so that the
+// reduced expressions do not turn into register pressure.
+static constexpr unsigned MaxNewIVsPerLoop = 8;
+
+PreservedAnalyses IVStrengthReductionOpt::run(Function &F, FunctionAnalysisManager &FAM) {
+  auto &LI = FAM.getResult<LoopAnalysis>(F);
+  auto &SE = FAM.getResult<ScalarEvolutionAnalysis>(F);
+  auto &ORE = FAM.getResult<OptimizationRemarkEmitterAnalysis>(F);
+  bool changed = false;
+
+  // Innermost loops first; reverse() does not extend the lifetime of a temporary
+  SmallVector<Loop*, 4> loops = LI.getLoopsInPreorder();
+  for (Loop *L : reverse(loops))
+    changed |= runOnLoop(L, LI, SE, ORE);
+
+  if (!changed) return PreservedAnalyses::all();
+
+  PreservedAnalyses PA;
+  PA.preserveSet<CFGAnalyses>();
+  return PA;
+}
+
+bool IVStrengthReductionOpt::runOnLoop(Loop *L, LoopInfo &LI, ScalarEvolution &SE,
+                                       OptimizationRemarkEmitter &ORE) {
+  TimeTraceScope scope("IVStrengthReductionOpt loop", [&] { return L->getHeader()->getName().str(); });
+
+  BasicBlock *preheader = L->getLoopPreheader();
+  BasicBlock *latch = L->getLoopLatch();
+  BasicBlock *header = L->getHeader();
+  if (!preheader || !latch) return false;
+
+  // Expressions that can be carried across iterations by an additive IV
+  auto isDerivedExpr = [](Instruction &I) -> bool {
+    switch (I.getOpcode()) {
+      case Instruction::Add:
+      case Instruction::Sub:
+      case Instruction::Mul:
+      case Instruction::Shl:
+      case Instruction::SExt:
+      case Instruction::ZExt:
+      case Instruction::Trunc:
+      case Instruction::GetElementPtr:
+        return true;
+      default:
+        return false;
+    }
+  };
+
+  SetVector<Instruction*> candidates;
+
+  // Collect multiplications by the IV and the affine expressions built on them
+  LoopBlocksRPO RPOT(L);
+  RPOT.perform(&LI);
+  for (BasicBlock *BB : RPOT) {
+    if (LI.getLoopFor(BB) != L) continue;
+
+    for (Instruction &I : *BB) {
+      bool derived = isDerivedExpr(I) && any_of(I.operands(), [&](Value *op) {
+        auto *OpInst = dyn_cast<Instruction>(op);
+        return OpInst && candidates.contains(OpInst);
+      });
+
+      if ((derived || isExpensiveIVExpr(I, L)) && getAffineAddRec(I, L, SE))
+        candidates.insert(&I);
+    }
+  }
+
+  if (candidates.empty()) return eliminateRedundantIVs(L, SE, ORE);
+
+  // A candidate whose users are all candidates is folded into them
+  auto isSubsumed = [&](Instruction *I) -> bool {
+    return all_of(I->users(), [&](User *user) {
+      auto *userInstr = dyn_cast<Instruction>(user);
+      return userInstr && candidates.contains(userInstr);
+    });
+  };
+
+  // Existing IVs are reused when they already compute the recurrence
+  DenseMap<const SCEV*, PHINode*> IVs;
+  for (PHINode &PN : header->phis())
+    if (auto *AR = getAffineAddRec(PN, L, SE))
+      IVs.try_emplace(AR, &PN);
+
+  SCEVExpander Rewriter(SE, header->getModule()->getDataLayout(), "ivsr");
+  Instruction *insertPt = preheader->getTerminator();
+  SmallVector<WeakTrackingVH> deadInsts;
+  unsigned newIVs = 0;
+
+  for (Instruction *I : candidates) {
+    if (isSubsumed(I)) continue;
+
+    const SCEVAddRecExpr *AR = getAffineAddRec(*I, L, SE);
+    PHINode *IV = IVs.lookup(AR);
+
+    if (!IV) {
+      const SCEV *start = AR->getStart();
+      const SCEV *step = AR->getStepRecurrence(SE);
+
+      if (newIVs == MaxNewIVsPerLoop) {
+        ORE.emit([&] {
+          return OptimizationRemarkMissed(DEBUG_TYPE, "TooManyIVs", I)
+                 << ore::NV("Inst", I) << " not reduced: the loop already has "
+                 << ore::NV("NewIVs", newIVs) << " new induction variables";
+        });
+        continue;
+      }
+      if (!Rewriter.isSafeToExpandAt(start, insertPt) || !Rewriter.isSafeToExpandAt(step, insertPt)) {
+        ORE.emit([&] {
+          return OptimizationRemarkMissed(DEBUG_TYPE, "NotExpandable", I)
+                 << ore::NV("Inst", I) << " not reduced: its start or step cannot be computed in the preheader";
+        });
+        continue;
+      }
+
+      Value *startV = Rewriter.expandCodeFor(start, I->getType(), insertPt);
+      Value *stepV = Rewriter.expandCodeFor(step, step->getType(), insertPt);
+
+      IRBuilder<> headerBuilder(&header->front());
+      IV = headerBuilder.CreatePHI(I->getType(), 2, "ivsr");
+
+      // Advance the IV in the latch: pointers by byte offset, integers by step
+      IRBuilder<> latchBuilder(latch->getTerminator());
+      Value *next = I->getType()->isPointerTy()
+        ? latchBuilder.CreateGEP(latchBuilder.getInt8Ty(), IV, stepV, "ivsr.next")
+        : latchBuilder.CreateAdd(IV, stepV, "ivsr.next");
+
+      IV->addIncoming(startV, preheader);
+      IV->addIncoming(next, latch);
+      IVs[AR] = IV;
+      newIVs++;
+      ++NumNewIVs;
+    }
+
+    ++NumReduced;
+    ORE.emit([&] {
+      return OptimizationRemark(DEBUG_TYPE, "StrengthReduced", I)
+             << ore::NV("Inst", I) << " replaced by the induction variable " << ore::NV("IV", IV->getName());
+    });
+    I->replaceAllUsesWith(IV);
+    deadInsts.push_back(I);
+  }
+
+  bool changed = !deadInsts.empty() || newIVs;
+  RecursivelyDeleteTriviallyDeadInstructions(deadInsts);
+  changed |= eliminateRedundantIVs(L, SE, ORE);
+
+  if (changed) SE.forgetLoop(L);
+  return changed;
+}
+
+bool IVStrengthReductionOpt::eliminateRedundantIVs(Loop *L, ScalarEvolution &SE, OptimizationRemarkEmitter &ORE) {
+  BasicBlock *preheader = L->getLoopPreheader();
+  BasicBlock *latch = L->getLoopLatch();
+  BasicBlock *header = L->getHeader();
+  bool changed = false;
+
+  SmallVector<WeakVH> phis;
+  for (PHINode &PN : header->phis())
+    phis.push_back(&PN);
+
+  // IVs computing the same recurrence as an earlier one
+  DenseMap<const SCEV*, PHINode*> IVs;
+  for (WeakVH &VH : phis) {
+    auto *PN = dyn_cast_or_null<PHINode>(VH);
+    auto *AR = PN ? getAffineAddRec(*PN, L, SE) : nullptr;
+    if (!AR) continue;
+
+    auto [it, inserted] = IVs.try_emplace(AR, PN);
+    if (inserted) continue;
+
+    // Structured bindings cannot be captured before C++20
+    PHINode *leader = it->second;
+    ++NumRedundantIVs;
+    ORE.emit([&] {
+      return OptimizationRemark(DEBUG_TYPE, "RedundantIV", PN)
+             << "induction variable " << ore::NV("IV", PN->getName()) << " replaced by "
+             << ore::NV("Replacement", leader->getName()) << ", with the same recurrence";
+    });
+    PN->replaceAllUsesWith(leader);
+    RecursivelyDeleteDeadPHINode(PN);
+    changed = true;
+  }
+
+  // Counter used only by the exit test: retarget the test on another IV
+  auto *exitBranch = dyn_cast<BranchInst>(latch->getTerminator());
+  if (!exitBranch || !exitBranch->isConditional() || L->getExitingBlock() != latch)
+    return changed;
+
+  auto *cmp = dyn_cast<ICmpInst>(exitBranch->getCondition());
+  if (!cmp || !cmp->hasOneUse() || cmp->getParent() != latch) return changed;
+
+  const SCEV *BTC = SE.getBackedgeTakenCount(L);
+  if (isa<SCEVCouldNotCompute>(BTC)) return changed;
+
+  // The counter is compared, before or after its increment, against an invariant
+  PHINode *counter = nullptr;
+  for (unsigned idx = 0; idx < 2; ++idx) {
+    Value *op = cmp->getOperand(idx);
+    if (!L->isLoopInvariant(cmp->getOperand(1 - idx))) continue;
+
+    for (PHINode &PN : header->phis())
+      if (op == &PN || op == PN.getIncomingValueForBlock(latch))
+        counter = &PN;
+  }
+  if (!counter) return changed;
+
+  Value *counterNext = counter->getIncomingValueForBlock(latch);
+  auto onlyFeedsExitTest = [&](Value *V) -> bool {
+    return all_of(V->users(), [&](User *user) {
+      return user == cmp || user == counter || user == counterNext;
+    });
+  };
+  if (!onlyFeedsExitTest(counter) || !onlyFeedsExitTest(counterNext)) return changed;
+
+  PHINode *replacement = nullptr;
+  for (PHINode &PN : header->phis()) {
+    auto *AR = getAffineAddRec(PN, L, SE);
+    if (&PN != counter && AR &&
+        (AR->hasNoSelfWrap() || AR->hasNoSignedWrap() || AR->hasNoUnsignedWrap())) {
+      replacement = &PN;
+      break;
+    }
+  }
+  if (!replacement) return changed;
+
+  // Post-increment value of the replacement IV on the last iteration
+  auto *AR = cast<SCEVAddRecExpr>(SE.getSCEV(replacement));
+  const SCEV *step = AR->getStepRecurrence(SE);
+  const SCEV *tripCount = SE.getAddExpr(SE.getTruncateOrZeroExtend(BTC, step->getType()), SE.getOne(step->getType()));
+  const SCEV *exitValue = SE.getAddExpr(AR->getStart(), SE.getMulExpr(step, tripCount));
+
+  SCEVExpander Rewriter(SE, header->getModule()->getDataLayout(), "ivsr");
+  Instruction *insertPt = preheader->getTerminator();
+  if (!Rewriter.isSafeToExpandAt(exitValue, insertPt)) return changed;
+
+  Value *limit = Rewriter.expandCodeFor(exitValue, replacement->getType(), insertPt);
+  bool exitsOnTrue = !L->contains(exitBranch->getSuccessor(0));
+  IRBuilder<> latchBuilder(exitBranch);
+  Value *newCmp = latchBuilder.CreateICmp(exitsOnTrue ? ICmpInst::ICMP_EQ : ICmpInst::ICMP_NE,
+    replacement->getIncomingValueForBlock(latch), limit, "ivsr.exitcond");
+
+  ++NumEliminatedCounters;
+  ORE.emit([&] {
+    return OptimizationRemark(DEBUG_TYPE, "EliminatedIV", counter)
+           << "loop counter " << ore::NV("IV", counter->getName()) << " replaced in the exit test by "
+           << ore::NV("Replacement", replacement->getName());
+  });
+  exitBranch->setCondition(newCmp);
+  cmp->eraseFromParent();
+  RecursivelyDeleteDeadPHINode(counter);
+  return true;
+}
+
+const SCEVAddRecExpr *IVStrengthReductionOpt::getAffineAddRec(Instruction &I, Loop *L, ScalarEvolution &SE) {
+  if (!SE.isSCEVable(I.getType())) return nullptr;
+
+  auto *AR = dyn_cast<SCEVAddRecExpr>(SE.getSCEV(&I));
+  if (!AR || AR->getLoop() != L || !AR->isAffine()) return nullptr;
+  if (AR->getStepRecurrence(SE)->isZero()) return nullptr;
+
+  return AR;
+}
+
+// Multiplications by a loop-varying value, e.g. i * c, i << 3
+bool IVStrengthReductionOpt::isExpensiveIVExpr(Instruction &I, Loop *L) {
+  auto opCode = I.getOpcode();
+  if (opCode != Instruction::Mul && opCode != Instruction::Shl) return false;
+
+  return any_of(I.operands(), [L](Value *op) { return !L->isLoopInvariant(op); });
+}
+
+PreservedAnalyses IVStrengthReductionLoopPass::run(Loop &L, LoopAnalysisManager &LAM,
+                                                   LoopStandardAnalysisResults &AR, LPMUpdater &U) {
+  OptimizationRemarkEmitter ORE(L.getHeader()->getParent());
+  if (!IVStrengthReductionOpt().runOnLoop(&L, AR.LI, AR.SE, ORE))
+    return PreservedAnalyses::all();
+
+  AR.SE.forgetLoop(&L);
+  return getLoopPassPreservedAnalyses();
+}
+
+PassPluginLibraryInfo getIVStrengthReductionPluginInfo() {
+  return {
+    LLVM_PLUGIN_API_VERSION,
+    "IVStrengthReductionOpt",
+    "v1.0",
+    [](PassBuilder &PB) {
+      PB.registerPipelineParsingCallback(
+        [](StringRef Name, FunctionPassManager &FPM,
+           ArrayRef<PassBuilder::PipelineElement>) {
+          if (Name == "IVSR-opt") {
+            FPM.addPass(IVStrengthReductionOpt());
+            return true;
+          }
+          return false;
+        });
+    }
+  };
+}
+
+// The unified plugin provides its own entry point
+#ifndef UNIFIED_PLUGIN
+extern "C" LLVM_ATTRIBUTE_WEAK ::llvm::PassPluginLibraryInfo
+llvmGetPassPluginInfo() {
+  return getIVStrengthReductionPluginInfo();
+}
+#endif
@@ -0,0 +1,49 @@
+#ifndef IV_STRENGTH_REDUCTION_OPT_H
+#define IV_STRENGTH_REDUCTION_OPT_H
+
+#include "llvm/IR/Function.h"
+#include "llvm/IR/IRBuilder.h"
+#include "llvm/IR/Instructions.h"
+#include "llvm/IR/PassManager.h"
+#include "llvm/Support/raw_ostream.h"
+#include "llvm/IR/Constants.h"
+#include "llvm/Passes/PassBuilder.h"
+#include "llvm/Passes/PassPlugin.h"
+#include "llvm/IR/InstrTypes.h"
+#include "llvm/IR/Module.h"
+
+#include "llvm/ADT/SetVector.h"
+#include "llvm/Analysis/LoopInfo.h"
+#include "llvm/Analysis/LoopIterator.h"
+#include "llvm/Analysis/OptimizationRemarkEmitter.h"
+#include "llvm/Analysis/ScalarEvolution.h"
+#include "llvm/Analysis/ScalarEvolutionExpressions.h"
+#include "llvm/IR/Dominators.h"
+#include "llvm/Support/TimeProfiler.h"
+#include "llvm/Transforms/Scalar/LoopPassManager.h"
+#include "llvm/Transforms/Utils/Local.h"
+#include "llvm/Transforms/Utils/ScalarEvolutionExpander.h"
+
+namespace llvm {
+
+class IVStrengthReductionOpt : public PassInfoMixin<IVStrengthReductionOpt> {
+    public:
+        PreservedAnalyses run(Function &F, FunctionAnalysisManager &FAM);
+        bool runOnLoop(Loop *L, LoopInfo &LI, ScalarEvolution &SE, OptimizationRemarkEmitter &ORE);
+        bool eliminateRedundantIVs(Loop *L, ScalarEvolution &SE, OptimizationRemarkEmitter &ORE);
+        static const SCEVAddRecExpr *getAffineAddRec(Instruction &I, Loop *L, ScalarEvolution &SE);
+        static bool isExpensiveIVExpr(Instruction &I, Loop *L);
+    };
+
+// IVStrengthReductionOpt on a single loop, for the loop pass pipelines
+class IVStrengthReductionLoopPass : public PassInfoMixin<IVStrengthReductionLoopPass> {
+    public:
+        PreservedAnalyses run(Loop &L, LoopAnalysisManager &LAM,
+                              LoopStandardAnalysisResults &AR, LPMUpdater &U);
+    };
+}
+
+// Pipeline names of this plugin, also registered by the unified plugin
+llvm::PassPluginLibraryInfo getIVStrengthReductionPluginInfo();
+
+#endif
@@ -0,0 +1,40 @@
+// REDUCIBLE: i * 8 becomes an IV stepping by 8
+int mulByConst(int n) {
+    int sum = 0;
+
+    for (int i = 0; i < n; i++)
+        sum += i * 8;
+
+    return sum;
+}
+
+// REDUCIBLE: base + i * stride address computation
+void stridedStore(int a[], int n, int stride) {
+    for (int i = 0; i < n; i++)
+        a[i * stride] = i;
+}
+
+// REDUCIBLE: derived expression (i * 3 + 5), counter used only by the exit test
+void derivedExpr(int a[], int n) {
+    for (int i = 0; i < n; i++)
+        a[i * 3 + 5] = 0;
+}
+
+// NOT REDUCED: i * m is a recurrence of the outer loop, computed in the inner
+// loop where it is invariant. LICM has to hoist it first; run_opt.sh only
+// runs IVSR-opt
+void nested(int a[], int n, int m) {
+    for (int i = 0; i < n; i++)
+        for (int j = 0; j < m; j++)
+            a[i * m + j] = i + j;
+}
+
+// NOT REDUCIBLE: i * i is not an affine recurrence
+int quadratic(int n) {
+    int sum = 0;
+
+    for (int i = 0; i < n; i++)
+        sum += i * i;
+
+    return sum;
+}
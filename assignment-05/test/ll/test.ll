@@ -0,0 +1,159 @@
+; ModuleID = 'test/bc/test.bc'
+source_filename = "test/cpp/test.cpp"
+target datalayout = "e-m:e-p270:32:32-p271:32:32-p272:64:64-i64:64-i128:128-f80:128-n8:16:32:64-S128"
+target triple = "x86_64-pc-linux-gnu"
+
+; Function Attrs: mustprogress noinline nounwind uwtable
+define dso_local noundef i32 @_Z10mulByConsti(i32 noundef %0) #0 {
+  br label %2
+
+2:                                                ; preds = %7, %1
+  %.01 = phi i32 [ 0, %1 ], [ %6, %7 ]
+  %.0 = phi i32 [ 0, %1 ], [ %8, %7 ]
+  %3 = icmp slt i32 %.0, %0
+  br i1 %3, label %4, label %9
+
+4:                                                ; preds = %2
+  %5 = mul nsw i32 %.0, 8
+  %6 = add nsw i32 %.01, %5
+  br label %7
+
+7:                                                ; preds = %4
+  %8 = add nsw i32 %.0, 1
+  br label %2, !llvm.loop !6
+
+9:                                                ; preds = %2
+  ret i32 %.01
+}
+
+; Function Attrs: mustprogress noinline nounwind uwtable
+define dso_local void @_Z12stridedStorePiii(ptr noundef %0, i32 noundef %1, i32 noundef %2) #0 {
+  br label %4
+
+4:                                                ; preds = %10, %3
+  %.0 = phi i32 [ 0, %3 ], [ %11, %10 ]
+  %5 = icmp slt i32 %.0, %1
+  br i1 %5, label %6, label %12
+
+6:                                                ; preds = %4
+  %7 = mul nsw i32 %.0, %2
+  %8 = sext i32 %7 to i64
+  %9 = getelementptr inbounds i32, ptr %0, i64 %8
+  store i32 %.0, ptr %9, align 4
+  br label %10
+
+10:                                               ; preds = %6
+  %11 = add nsw i32 %.0, 1
+  br label %4, !llvm.loop !8
+
+12:                                               ; preds = %4
+  ret void
+}
+
+; Function Attrs: mustprogress noinline nounwind uwtable
+define dso_local void @_Z11derivedExprPii(ptr noundef %0, i32 noundef %1) #0 {
+  br label %3
+
+3:                                                ; preds = %10, %2
+  %.0 = phi i32 [ 0, %2 ], [ %11, %10 ]
+  %4 = icmp slt i32 %.0, %1
+  br i1 %4, label %5, label %12
+
+5:                                                ; preds = %3
+  %6 = mul nsw i32 %.0, 3
+  %7 = add nsw i32 %6, 5
+  %8 = sext i32 %7 to i64
+  %9 = getelementptr inbounds i32, ptr %0, i64 %8
+  store i32 0, ptr %9, align 4
+  br label %10
+
+10:                                               ; preds = %5
+  %11 = add nsw i32 %.0, 1
+  br label %3, !llvm.loop !9
+
+12:                                               ; preds = %3
+  ret void
+}
+
+; Function Attrs: mustprogress noinline nounwind uwtable
+define dso_local void @_Z6nestedPiii(ptr noundef %0, i32 noundef %1, i32 noundef %2) #0 {
+  br label %4
+
+4:                                                ; preds = %18, %3
+  %.01 = phi i32 [ 0, %3 ], [ %19, %18 ]
+  %5 = icmp slt i32 %.01, %1
+  br i1 %5, label %6, label %20
+
+6:                                                ; preds = %4
+  br label %7
+
+7:                                                ; preds = %15, %6
+  %.0 = phi i32 [ 0, %6 ], [ %16, %15 ]
+  %8 = icmp slt i32 %.0, %2
+  br i1 %8, label %9, label %17
+
+9:                                                ; preds = %7
+  %10 = add nsw i32 %.01, %.0
+  %11 = mul nsw i32 %.01, %2
+  %12 = add nsw i32 %11, %.0
+  %13 = sext i32 %12 to i64
+  %14 = getelementptr inbounds i32, ptr %0, i64 %13
+  store i32 %10, ptr %14, align 4
+  br label %15
+
+15:                                               ; preds = %9
+  %16 = add nsw i32 %.0, 1
+  br label %7, !llvm.loop !10
+
+17:                                               ; preds = %7
+  br label %18
+
+18:                                               ; preds = %17
+  %19 = add nsw i32 %.01, 1
+  br label %4, !llvm.loop !11
+
+20:                                               ; preds = %4
+  ret void
+}
+
+; Function Attrs: mustprogress noinline nounwind uwtable
+define dso_local noundef i32 @_Z9quadratici(i32 noundef %0) #0 {
+  br label %2
+
+2:                                                ; preds = %7, %1
+  %.01 = phi i32 [ 0, %1 ], [ %6, %7 ]
+  %.0 = phi i32 [ 0, %1 ], [ %8, %7 ]
+  %3 = icmp slt i32 %.0, %0
+  br i1 %3, label %4, label %9
+
+4:                                                ; preds = %2
+  %5 = mul nsw i32 %.0, %.0
+  %6 = add nsw i32 %.01, %5
+  br label %7
+
+7:                                                ; preds = %4
+  %8 = add nsw i32 %.0, 1
+  br label %2, !llvm.loop !12
+
+9:                                                ; preds = %2
+  ret i32 %.01
+}
+
+attributes #0 = { mustprogress noinline nounwind uwtable "frame-pointer"="all" "min-legal-vector-width"="0" "no-trapping-math"="true" "stack-protector-buffer-size"="8" "target-cpu"="x86-64" "target-features"="+cmov,+cx8,+fxsr,+mmx,+sse,+sse2,+x87" "tune-cpu"="generic" }
+
+!llvm.module.flags = !{!0, !1, !2, !3, !4}
+!llvm.ident = !{!5}
+
+!0 = !{i32 1, !"wchar_size", i32 4}
+!1 = !{i32 8, !"PIC Level", i32 2}
+!2 = !{i32 7, !"PIE Level", i32 2}
+!3 = !{i32 7, !"uwtable", i32 2}
+!4 = !{i32 7, !"frame-pointer", i32 2}
+!5 = !{!"Ubuntu clang version 19.1.7 (++20250114103320+cd708029e0b2-1~exp1~20250114103432.75)"}
+!6 = distinct !{!6, !7}
+!7 = !{!"llvm.loop.mustprogress"}
+!8 = distinct !{!8, !7}
+!9 = distinct !{!9, !7}
+!10 = distinct !{!10, !7}
+!11 = distinct !{!11, !7}
+!12 = distinct !{!12, !7}
@@ -0,0 +1,191 @@
+; ModuleID = 'test/bc/test.opt.bc'
+source_filename = "test/cpp/test.cpp"
+target datalayout = "e-m:e-p270:32:32-p271:32:32-p272:64:64-i64:64-i128:128-f80:128-n8:16:32:64-S128"
+target triple = "x86_64-pc-linux-gnu"
+
+; Function Attrs: mustprogress noinline nounwind uwtable
+define dso_local noundef i32 @_Z10mulByConsti(i32 noundef %0) #0 {
+  %2 = icmp slt i32 0, %0
+  br i1 %2, label %.lr.ph, label %8
+
+.lr.ph:                                           ; preds = %1
+  br label %3
+
+3:                                                ; preds = %.lr.ph, %5
+  %ivsr = phi i32 [ 0, %.lr.ph ], [ %ivsr.next, %5 ]
+  %.02 = phi i32 [ 0, %.lr.ph ], [ %6, %5 ]
+  %.011 = phi i32 [ 0, %.lr.ph ], [ %4, %5 ]
+  %4 = add nsw i32 %.011, %ivsr
+  br label %5
+
+5:                                                ; preds = %3
+  %6 = add nsw i32 %.02, 1
+  %7 = icmp slt i32 %6, %0
+  %ivsr.next = add i32 %ivsr, 8
+  br i1 %7, label %3, label %._crit_edge, !llvm.loop !6
+
+._crit_edge:                                      ; preds = %5
+  %split = phi i32 [ %4, %5 ]
+  br label %8
+
+8:                                                ; preds = %._crit_edge, %1
+  %.01.lcssa = phi i32 [ %split, %._crit_edge ], [ 0, %1 ]
+  ret i32 %.01.lcssa
+}
+
+; Function Attrs: mustprogress noinline nounwind uwtable
+define dso_local void @_Z12stridedStorePiii(ptr noundef %0, i32 noundef %1, i32 noundef %2) #0 {
+  %4 = icmp slt i32 0, %1
+  br i1 %4, label %.lr.ph, label %11
+
+.lr.ph:                                           ; preds = %3
+  %5 = sext i32 %2 to i64
+  %6 = shl nsw i64 %5, 2
+  br label %7
+
+7:                                                ; preds = %.lr.ph, %8
+  %ivsr = phi ptr [ %0, %.lr.ph ], [ %ivsr.next, %8 ]
+  %.01 = phi i32 [ 0, %.lr.ph ], [ %9, %8 ]
+  store i32 %.01, ptr %ivsr, align 4
+  br label %8
+
+8:                                                ; preds = %7
+  %9 = add nsw i32 %.01, 1
+  %10 = icmp slt i32 %9, %1
+  %ivsr.next = getelementptr i8, ptr %ivsr, i64 %6
+  br i1 %10, label %7, label %._crit_edge, !llvm.loop !8
+
+._crit_edge:                                      ; preds = %8
+  br label %11
+
+11:                                               ; preds = %._crit_edge, %3
+  ret void
+}
+
+; Function Attrs: mustprogress noinline nounwind uwtable
+define dso_local void @_Z11derivedExprPii(ptr noundef %0, i32 noundef %1) #0 {
+  %3 = icmp slt i32 0, %1
+  br i1 %3, label %.lr.ph, label %10
+
+.lr.ph:                                           ; preds = %2
+  %uglygep = getelementptr i8, ptr %0, i64 20
+  %4 = add i32 %1, -1
+  %5 = zext i32 %4 to i64
+  %6 = mul nuw nsw i64 %5, 12
+  %7 = add nuw nsw i64 %6, 32
+  %uglygep1 = getelementptr i8, ptr %0, i64 %7
+  br label %8
+
+8:                                                ; preds = %.lr.ph, %9
+  %ivsr = phi ptr [ %uglygep, %.lr.ph ], [ %ivsr.next, %9 ]
+  store i32 0, ptr %ivsr, align 4
+  br label %9
+
+9:                                                ; preds = %8
+  %ivsr.next = getelementptr i8, ptr %ivsr, i64 12
+  %ivsr.exitcond = icmp ne ptr %ivsr.next, %uglygep1
+  br i1 %ivsr.exitcond, label %8, label %._crit_edge, !llvm.loop !9
+
+._crit_edge:                                      ; preds = %9
+  br label %10
+
+10:                                               ; preds = %._crit_edge, %2
+  ret void
+}
+
+; Function Attrs: mustprogress noinline nounwind uwtable
+define dso_local void @_Z6nestedPiii(ptr noundef %0, i32 noundef %1, i32 noundef %2) #0 {
+  %4 = icmp slt i32 0, %1
+  br i1 %4, label %.lr.ph5, label %20
+
+.lr.ph5:                                          ; preds = %3
+  br label %5
+
+5:                                                ; preds = %.lr.ph5, %17
+  %.013 = phi i32 [ 0, %.lr.ph5 ], [ %18, %17 ]
+  %6 = icmp slt i32 0, %2
+  br i1 %6, label %.lr.ph, label %16
+
+.lr.ph:                                           ; preds = %5
+  br label %7
+
+7:                                                ; preds = %.lr.ph, %13
+  %.02 = phi i32 [ 0, %.lr.ph ], [ %14, %13 ]
+  %8 = add nsw i32 %.013, %.02
+  %9 = mul nsw i32 %.013, %2
+  %10 = add nsw i32 %9, %.02
+  %11 = sext i32 %10 to i64
+  %12 = getelementptr inbounds i32, ptr %0, i64 %11
+  store i32 %8, ptr %12, align 4
+  br label %13
+
+13:                                               ; preds = %7
+  %14 = add nsw i32 %.02, 1
+  %15 = icmp slt i32 %14, %2
+  br i1 %15, label %7, label %._crit_edge, !llvm.loop !10
+
+._crit_edge:                                      ; preds = %13
+  br label %16
+
+16:                                               ; preds = %._crit_edge, %5
+  br label %17
+
+17:                                               ; preds = %16
+  %18 = add nsw i32 %.013, 1
+  %19 = icmp slt i32 %18, %1
+  br i1 %19, label %5, label %._crit_edge6, !llvm.loop !11
+
+._crit_edge6:                                     ; preds = %17
+  br label %20
+
+20:                                               ; preds = %._crit_edge6, %3
+  ret void
+}
+
+; Function Attrs: mustprogress noinline nounwind uwtable
+define dso_local noundef i32 @_Z9quadratici(i32 noundef %0) #0 {
+  %2 = icmp slt i32 0, %0
+  br i1 %2, label %.lr.ph, label %9
+
+.lr.ph:                                           ; preds = %1
+  br label %3
+
+3:                                                ; preds = %.lr.ph, %6
+  %.02 = phi i32 [ 0, %.lr.ph ], [ %7, %6 ]
+  %.011 = phi i32 [ 0, %.lr.ph ], [ %5, %6 ]
+  %4 = mul nsw i32 %.02, %.02
+  %5 = add nsw i32 %.011, %4
+  br label %6
+
+6:                                                ; preds = %3
+  %7 = add nsw i32 %.02, 1
+  %8 = icmp slt i32 %7, %0
+  br i1 %8, label %3, label %._crit_edge, !llvm.loop !12
+
+._crit_edge:                                      ; preds = %6
+  %split = phi i32 [ %5, %6 ]
+  br label %9
+
+9:                                                ; preds = %._crit_edge, %1
+  %.01.lcssa = phi i32 [ %split, %._crit_edge ], [ 0, %1 ]
+  ret i32 %.01.lcssa
+}
+
+attributes #0 = { mustprogress noinline nounwind uwtable "frame-pointer"="all" "min-legal-vector-width"="0" "no-trapping-math"="true" "stack-protector-buffer-size"="8" "target-cpu"="x86-64" "target-features"="+cmov,+cx8,+fxsr,+mmx,+sse,+sse2,+x87" "tune-cpu"="generic" }
+
+!llvm.module.flags = !{!0, !1, !2, !3, !4}
+!llvm.ident = !{!5}
+
+!0 = !{i32 1, !"wchar_size", i32 4}
+!1 = !{i32 8, !"PIC Level", i32 2}
+!2 = !{i32 7, !"PIE Level", i32 2}
+!3 = !{i32 7, !"uwtable", i32 2}
+!4 = !{i32 7, !"frame-pointer", i32 2}
+!5 = !{!"Ubuntu clang version 19.1.7 (++20250114103320+cd708029e0b2-1~exp1~20250114103432.75)"}
+!6 = distinct !{!6, !7}
+!7 = !{!"llvm.loop.mustprogress"}
+!8 = distinct !{!8, !7}
+!9 = distinct !{!9, !7}
+!10 = distinct !{!10, !7}
+!11 = distinct !{!11, !7}
+!12 = distinct !{!12, !7}
@@ -0,0 +1,472 @@
+// Runtime benchmark and differential test of a pass pipeline:
+//
+//   pass-bench -passes="loop-simplify,loop-rotate,LICM-opt" -o licm.json \
+//              bench/ll/*.ll
+//
+// Every function of the inputs is JIT-compiled twice, as parsed and after the
+// pipeline. Both versions run on the same generated arguments: integers in
+// [-max-int, max-int], booleans, and a buffer of random bytes for every
+// pointer. As many more inputs mix in the edge values 0, 1, -1, and the
+// minimum and maximum of the type, e.g. INT_MIN / -1 for a signed division.
+// Their return values and buffers must be equal, else the function is reported
+// as a mismatch and the exit status is 1, as when only the optimized version
+// times out. The check runs in a child process; an input on which the parsed
+// version traps or times out is skipped. Then both versions are timed on the
+// inputs without edge values, one sample of each in turn: -warmup runs, then
+// -samples samples of -iterations runs on every input. The JSON report gives
+// the median time per call and its 95% confidence interval.
+#include "Pipeline.h"
+#include "Plugin.h"
+
+#include "llvm/Config/llvm-config.h"
+#include "llvm/ExecutionEngine/Orc/ExecutionUtils.h"
+#include "llvm/ExecutionEngine/Orc/LLJIT.h"
+#include "llvm/IR/IRBuilder.h"
+#include "llvm/IR/LLVMContext.h"
+#include "llvm/IR/Verifier.h"
+#include "llvm/IRReader/IRReader.h"
+#include "llvm/Support/CommandLine.h"
+#include "llvm/Support/InitLLVM.h"
+#include "llvm/Support/JSON.h"
+#include "llvm/Support/SourceMgr.h"
+#include "llvm/Support/TargetSelect.h"
+#include "llvm/Support/ToolOutputFile.h"
+#include "llvm/Support/WithColor.h"
+#include "llvm/Transforms/Utils/Cloning.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cerrno>
+#include <cmath>
+#include <csignal>
+#include <cstring>
+#include <random>
+
+#include <sys/time.h>
+#include <sys/wait.h>
+#include <unistd.h>
+using namespace llvm;
+
+static cl::list<std::string> InputFiles(cl::Positional, cl::OneOrMore,
+    cl::desc("<input .ll/.bc files>"));
+static cl::opt<std::string> PassPipeline("passes", cl::Required,
+    cl::desc("Pipeline to evaluate, in the syntax of opt -passes"));
+static cl::opt<std::string> OutputFile("o", cl::Required, cl::value_desc("file"),
+    cl::desc("JSON report"));
+static cl::opt<unsigned> NumInputs("inputs", cl::init(16),
+    cl::desc("Generated argument lists per function, and as many with edge values"));
+static cl::opt<unsigned> MaxInt("max-int", cl::init(64),
+    cl::desc("Integer arguments are drawn from [-max-int, max-int]"));
+static cl::opt<unsigned> Warmup("warmup", cl::init(5),
+    cl::desc("Untimed runs on every input before the samples"));
+static cl::opt<unsigned> Samples("samples", cl::init(31),
+    cl::desc("Timed samples of each version"));
+static cl::opt<unsigned> Iterations("iterations", cl::init(100),
+    cl::desc("Runs on every input in one sample"));
+static cl::opt<unsigned> Seed("seed", cl::init(1),
+    cl::desc("Seed of the generated inputs"));
+
+static ExitOnError ExitOnErr;
+
+namespace {
+
+// Arguments in 8-byte slots, the result in the last one (see createWrapper)
+using WrapperFn = void (*)(uint64_t *Args, uint64_t *Result);
+
+// One generated argument list. The slots of the pointer arguments are filled
+// by Run, with the address of the middle of its copy of their buffer.
+struct Input {
+  SmallVector<uint64_t> Args;
+  SmallVector<unsigned> PointerArgs;
+  std::vector<std::vector<uint8_t>> Buffers;
+  bool PointerResult = false;
+  // Checked, but not timed
+  bool Edge = false;
+};
+
+// The state of one call: arguments, result and a private copy of the buffers
+struct Run {
+  SmallVector<uint64_t> Args;
+  uint64_t Result = 0;
+  std::vector<std::vector<uint8_t>> Buffers;
+  bool PointerResult;
+
+  explicit Run(const Input &In) : Args(In.Args), Buffers(In.Buffers), PointerResult(In.PointerResult) {
+    for (unsigned i = 0; i < In.PointerArgs.size(); ++i)
+      Args[In.PointerArgs[i]] = reinterpret_cast<uintptr_t>(Buffers[i].data() + Buffers[i].size() / 2);
+  }
+  // A copy would point to the buffers of the original
+  Run(const Run&) = delete;
+  Run(Run&&) = default;
+
+  void call(WrapperFn Fn) { Fn(Args.data(), &Result); }
+
+  // A returned pointer into a buffer, as the buffer number (from 1) and the
+  // offset in it: each run has its own copy of the buffers
+  std::pair<uint64_t, uint64_t> getResult() const {
+    for (unsigned i = 0; PointerResult && i < Buffers.size(); ++i) {
+      uintptr_t Begin = reinterpret_cast<uintptr_t>(Buffers[i].data());
+      if (Result >= Begin && Result <= Begin + Buffers[i].size()) return {i + 1, Result - Begin};
+    }
+    return {0, Result};
+  }
+  bool operator==(const Run &Other) const { return getResult() == Other.getResult() && Buffers == Other.Buffers; }
+};
+
+// Time per call, in nanoseconds
+struct Summary {
+  double Median = 0, Low = 0, High = 0, Min = 0;
+};
+
+struct FunctionResult {
+  std::string File, Name;
+  // "ok", "mismatch", "timeout" (of the optimized version only), "trap" (the
+  // parsed version traps or times out on every input to time), "unsupported"
+  // or "removed" (by the pipeline)
+  std::string Status;
+  // The input of a mismatch or timeout
+  unsigned MismatchInput = 0;
+  Summary Baseline, Optimized;
+};
+
+}
+
+static void reportError(StringRef File, const Twine &Msg) {
+  WithColor::error(errs(), "pass-bench") << File << ": " << Msg << "\n";
+}
+
+static bool isSupportedType(Type *Ty) {
+  return (Ty->isIntegerTy() && Ty->getIntegerBitWidth() <= 64) || Ty->isFloatTy() ||
+         Ty->isDoubleTy() || Ty->isPointerTy();
+}
+
+static bool isSupported(const Function &F) {
+  if (F.isDeclaration() || !F.hasName() || F.isVarArg()) return false;
+  if (!F.getReturnType()->isVoidTy() && !isSupportedType(F.getReturnType())) return false;
+  return all_of(F.args(), [](const Argument &A) { return isSupportedType(A.getType()); });
+}
+
+static std::string getWrapperName(StringRef Name) {
+  return ("__bench." + Name).str();
+}
+
+// Calls F with the arguments loaded from the slots of the first parameter,
+// and stores the result to the second one: one signature for the harness to
+// call. Added after the pipeline, which then cannot inline F.
+static void createWrapper(Function &F) {
+  LLVMContext &Ctx = F.getContext();
+  Type *PtrTy = PointerType::getUnqual(Ctx);
+  FunctionType *FTy = FunctionType::get(Type::getVoidTy(Ctx), {PtrTy, PtrTy}, false);
+  Function *Wrapper = Function::Create(FTy, GlobalValue::ExternalLinkage, getWrapperName(F.getName()), F.getParent());
+
+  IRBuilder<> Builder(BasicBlock::Create(Ctx, "entry", Wrapper));
+  SmallVector<Value*> Args;
+  for (Argument &A : F.args()) {
+    Value *Slot = Builder.CreateConstGEP1_64(Builder.getInt64Ty(), Wrapper->getArg(0), A.getArgNo());
+    Args.push_back(Builder.CreateLoad(A.getType(), Slot));
+  }
+  CallInst *Call = Builder.CreateCall(&F, Args);
+  Call->setCallingConv(F.getCallingConv());
+  if (!F.getReturnType()->isVoidTy())
+    Builder.CreateStore(Call, Wrapper->getArg(1));
+  Builder.CreateRetVoid();
+}
+
+// With Edge, every integer argument is an edge value of its type half of the
+// time: 0, 1, -1, the signed minimum or maximum
+static Input generateInput(const Function &F, std::mt19937_64 &Rng, bool Edge) {
+  std::uniform_int_distribution<int64_t> IntDist(-int64_t(MaxInt), int64_t(MaxInt));
+  std::uniform_int_distribution<unsigned> EdgeDist(0, 9);
+  std::uniform_int_distribution<unsigned> ByteDist(0, 255);
+  // Room for a[i * n + j] with |i|, |j|, |n| <= max-int, of 8-byte elements,
+  // on both sides of the address passed
+  size_t BufferSize = (size_t(MaxInt) * MaxInt + 8 * MaxInt + 64) * 8 * 2;
+
+  Input In;
+  In.PointerResult = F.getReturnType()->isPointerTy();
+  In.Edge = Edge;
+  for (const Argument &A : F.args()) {
+    Type *Ty = A.getType();
+    uint64_t Slot = 0;
+    if (Ty->isIntegerTy(1)) {
+      Slot = Rng() & 1;
+    } else if (Ty->isIntegerTy()) {
+      unsigned Width = Ty->getIntegerBitWidth();
+      int64_t Min = Width == 64 ? INT64_MIN : -(int64_t(1) << (Width - 1));
+      int64_t Values[] = {0, 1, -1, Min, -(Min + 1)};
+      unsigned Pick = Edge ? EdgeDist(Rng) : 5;
+      Slot = Pick < 5 ? uint64_t(Values[Pick]) : uint64_t(IntDist(Rng));
+    } else if (Ty->isFloatTy()) {
+      float V = float(IntDist(Rng));
+      std::memcpy(&Slot, &V, sizeof(V));
+    } else if (Ty->isDoubleTy()) {
+      double V = double(IntDist(Rng));
+      std::memcpy(&Slot, &V, sizeof(V));
+    } else {
+      std::vector<uint8_t> Buffer(BufferSize);
+      for (uint8_t &Byte : Buffer) Byte = ByteDist(Rng);
+      In.PointerArgs.push_back(A.getArgNo());
+      In.Buffers.push_back(std::move(Buffer));
+    }
+    In.Args.push_back(Slot);
+  }
+  return In;
+}
+
+// Median, distribution-free 95% confidence interval of the median (order
+// statistics n/2 -+ 1.96 sqrt(n)/2) and minimum
+static Summary summarize(std::vector<double> Times) {
+  Summary S;
+  if (Times.empty()) return S;
+  std::sort(Times.begin(), Times.end());
+
+  size_t N = Times.size();
+  S.Median = N % 2 ? Times[N / 2] : (Times[N / 2 - 1] + Times[N / 2]) / 2;
+  double Delta = 1.96 * std::sqrt(double(N)) / 2;
+  size_t Low = size_t(std::max(0.0, std::floor(N / 2.0 - Delta)));
+  size_t High = size_t(std::min(double(N - 1), std::ceil(N / 2.0 + Delta)));
+  S.Low = Times[Low];
+  S.High = Times[High];
+  S.Min = Times.front();
+  return S;
+}
+
+// Time per call of one sample
+static double timeSample(WrapperFn Fn, std::vector<Run> &Runs) {
+  auto Start = std::chrono::steady_clock::now();
+  for (unsigned It = 0; It < Iterations; ++It) {
+    for (Run &R : Runs) R.call(Fn);
+  }
+  std::chrono::duration<double, std::nano> Elapsed = std::chrono::steady_clock::now() - Start;
+  return Elapsed.count() / (double(Iterations) * Runs.size());
+}
+
+enum class CheckResult { Equal, Different, TimedOut, Skipped };
+
+static constexpr long CheckTimeoutUs = 500000;
+
+static void exitOptimizedTrapped(int) { _exit(2); }
+static void exitOptimizedTimedOut(int) { _exit(3); }
+
+static void startCheckTimer(long Us) {
+  itimerval Timer = {{0, 0}, {Us / 1000000, Us % 1000000}};
+  setitimer(ITIMER_REAL, &Timer, nullptr);
+}
+
+// Runs both versions on In in a child process, which an edge value can make
+// trap, loop for ages or write out of the buffers. Skipped if the parsed
+// version traps or times out: the optimized one then has nothing to match.
+// The optimized version has four times as long as the parsed one took, and
+// at least the same limit: past it, the pass made the function hang.
+static CheckResult checkInput(WrapperFn Baseline, WrapperFn Optimized, const Input &In) {
+  const int TrapSignals[] = {SIGFPE, SIGSEGV, SIGBUS, SIGILL, SIGABRT};
+  pid_t Pid = fork();
+  if (Pid < 0) ExitOnErr(errorCodeToError(std::error_code(errno, std::generic_category())));
+  if (Pid == 0) {
+    // Killed by the signal, without the stack trace of the LLVM handlers
+    for (int Signal : TrapSignals) std::signal(Signal, SIG_DFL);
+    std::signal(SIGALRM, SIG_DFL);
+    Run Expected(In), Actual(In);
+    startCheckTimer(CheckTimeoutUs);
+    auto Start = std::chrono::steady_clock::now();
+    Expected.call(Baseline);
+    std::chrono::duration<double, std::micro> Elapsed = std::chrono::steady_clock::now() - Start;
+
+    for (int Signal : TrapSignals) std::signal(Signal, exitOptimizedTrapped);
+    std::signal(SIGALRM, exitOptimizedTimedOut);
+    startCheckTimer(std::max(CheckTimeoutUs, long(4 * Elapsed.count())));
+    Actual.call(Optimized);
+    _exit(Expected == Actual ? 0 : 1);
+  }
+
+  int Status;
+  while (waitpid(Pid, &Status, 0) < 0 && errno == EINTR) {}
+  if (!WIFEXITED(Status)) return CheckResult::Skipped;
+  if (WEXITSTATUS(Status) == 3) return CheckResult::TimedOut;
+  return WEXITSTATUS(Status) == 0 ? CheckResult::Equal : CheckResult::Different;
+}
+
+static void measure(FunctionResult &Result, WrapperFn Baseline, WrapperFn Optimized, ArrayRef<Input> Inputs) {
+  std::vector<Run> BaselineRuns, OptimizedRuns;
+  for (unsigned i = 0; i < Inputs.size(); ++i) {
+    CheckResult Check = checkInput(Baseline, Optimized, Inputs[i]);
+    if (Check == CheckResult::Different || Check == CheckResult::TimedOut) {
+      Result.Status = Check == CheckResult::Different ? "mismatch" : "timeout";
+      Result.MismatchInput = i;
+      return;
+    }
+    if (Check == CheckResult::Skipped || Inputs[i].Edge) continue;
+    BaselineRuns.emplace_back(Inputs[i]);
+    OptimizedRuns.emplace_back(Inputs[i]);
+  }
+  if (BaselineRuns.empty()) {
+    Result.Status = "trap";
+    return;
+  }
+
+  for (unsigned i = 0; i < Warmup; ++i) {
+    for (Run &R : BaselineRuns) R.call(Baseline);
+    for (Run &R : OptimizedRuns) R.call(Optimized);
+  }
+
+  // Interleaved, so that both versions see the same machine state
+  std::vector<double> BaselineTimes, OptimizedTimes;
+  for (unsigned i = 0; i < Samples; ++i) {
+    BaselineTimes.push_back(timeSample(Baseline, BaselineRuns));
+    OptimizedTimes.push_back(timeSample(Optimized, OptimizedRuns));
+  }
+  Result.Status = "ok";
+  Result.Baseline = summarize(std::move(BaselineTimes));
+  Result.Optimized = summarize(std::move(OptimizedTimes));
+}
+
+static orc::JITDylib &createDylib(orc::LLJIT &J, const Twine &Name) {
+  orc::JITDylib &JD = ExitOnErr(J.createJITDylib(Name.str()));
+  JD.addGenerator(ExitOnErr(orc::DynamicLibrarySearchGenerator::GetForCurrentProcess(
+      J.getDataLayout().getGlobalPrefix())));
+  return JD;
+}
+
+static bool benchmarkFile(orc::LLJIT &J, OptPipeline &Pipeline, StringRef File,
+                          std::mt19937_64 &Rng, std::vector<FunctionResult> &Results) {
+  // Declared first, to outlive the modules
+  orc::ThreadSafeContext TSCtx(std::make_unique<LLVMContext>());
+  SMDiagnostic Diag;
+  std::unique_ptr<Module> Baseline = parseIRFile(File, Diag, *TSCtx.getContext());
+  if (!Baseline) {
+    Diag.print("pass-bench", errs());
+    return false;
+  }
+  if (Baseline->getDataLayout().isDefault())
+    Baseline->setDataLayout(J.getDataLayout());
+
+  std::unique_ptr<Module> Optimized = CloneModule(*Baseline);
+  Pipeline.run(*Optimized);
+  std::string VerifyErrors;
+  raw_string_ostream VerifyOS(VerifyErrors);
+  if (verifyModule(*Optimized, &VerifyOS)) {
+    reportError(File, "broken module after optimization\n" + VerifyOS.str());
+    return false;
+  }
+
+  // The inputs are generated before any version runs
+  SmallVector<std::pair<size_t, std::vector<Input>>> Benchmarked;
+  for (Function &F : *Baseline) {
+    if (F.isDeclaration() || F.getName().starts_with("__bench.")) continue;
+    FunctionResult Result{File.str(), F.getName().str(), "", 0, {}, {}};
+
+    Function *OptF = Optimized->getFunction(F.getName());
+    if (!isSupported(F)) {
+      Result.Status = "unsupported";
+    } else if (!OptF || OptF->isDeclaration() || OptF->getFunctionType() != F.getFunctionType()) {
+      Result.Status = "removed";
+    } else {
+      std::vector<Input> Inputs;
+      for (unsigned i = 0; i < 2 * NumInputs; ++i)
+        Inputs.push_back(generateInput(F, Rng, /*Edge=*/i >= NumInputs));
+      Benchmarked.emplace_back(Results.size(), std::move(Inputs));
+      createWrapper(F);
+      createWrapper(*OptF);
+    }
+    Results.push_back(std::move(Result));
+  }
+
+  orc::JITDylib &BaselineJD = createDylib(J, "baseline." + File);
+  orc::JITDylib &OptimizedJD = createDylib(J, "optimized." + File);
+  if (Error Err = J.addIRModule(BaselineJD, orc::ThreadSafeModule(std::move(Baseline), TSCtx))) {
+    reportError(File, toString(std::move(Err)));
+    return false;
+  }
+  ExitOnErr(J.addIRModule(OptimizedJD, orc::ThreadSafeModule(std::move(Optimized), TSCtx)));
+
+  for (auto &[Idx, Inputs] : Benchmarked) {
+    FunctionResult &Result = Results[Idx];
+    std::string WrapperName = getWrapperName(Result.Name);
+    auto BaselineFn = ExitOnErr(J.lookup(BaselineJD, WrapperName)).toPtr<WrapperFn>();
+    auto OptimizedFn = ExitOnErr(J.lookup(OptimizedJD, WrapperName)).toPtr<WrapperFn>();
+    measure(Result, BaselineFn, OptimizedFn, Inputs);
+  }
+  return true;
+}
+
+static void writeSummary(json::OStream &JOS, StringRef Name, const Summary &S) {
+  JOS.attributeObject(Name, [&] {
+    JOS.attribute("median_ns", S.Median);
+    JOS.attributeArray("ci95_ns", [&] {
+      JOS.value(S.Low);
+      JOS.value(S.High);
+    });
+    JOS.attribute("min_ns", S.Min);
+  });
+}
+
+static void writeReport(raw_ostream &OS, ArrayRef<FunctionResult> Results) {
+  json::OStream JOS(OS, 2);
+  JOS.object([&] {
+    JOS.attribute("passes", PassPipeline);
+    JOS.attribute("plugin", getLLVMOptimizationsPluginInfo().PluginVersion);
+    JOS.attribute("llvm", LLVM_VERSION_STRING);
+    JOS.attribute("seed", int64_t(Seed));
+    JOS.attribute("inputs", int64_t(NumInputs));
+    JOS.attribute("samples", int64_t(Samples));
+    JOS.attribute("iterations", int64_t(Iterations));
+
+    JOS.attributeArray("functions", [&] {
+      for (const FunctionResult &R : Results) {
+        JOS.object([&] {
+          JOS.attribute("file", R.File);
+          JOS.attribute("function", R.Name);
+          JOS.attribute("status", R.Status);
+          if (R.Status == "mismatch" || R.Status == "timeout") JOS.attribute("input", int64_t(R.MismatchInput));
+          if (R.Status != "ok") return;
+          writeSummary(JOS, "baseline", R.Baseline);
+          writeSummary(JOS, "optimized", R.Optimized);
+          JOS.attribute("speedup", R.Baseline.Median / R.Optimized.Median);
+        });
+      }
+    });
+  });
+  OS << "\n";
+}
+
+int main(int argc, char **argv) {
+  InitLLVM X(argc, argv);
+  InitializeNativeTarget();
+  InitializeNativeTargetAsmPrinter();
+  cl::ParseCommandLineOptions(argc, argv, "Runtime benchmark of a pass pipeline\n");
+  ExitOnErr.setBanner("pass-bench: ");
+
+  Expected<std::unique_ptr<OptPipeline>> Pipeline = OptPipeline::create(PassPipeline);
+  if (!Pipeline) {
+    reportError("-passes", toString(Pipeline.takeError()));
+    return 1;
+  }
+
+  std::unique_ptr<orc::LLJIT> J = ExitOnErr(orc::LLJITBuilder().create());
+  std::mt19937_64 Rng(Seed);
+  std::vector<FunctionResult> Results;
+  bool Failed = false;
+
+  for (const std::string &File : InputFiles)
+    Failed |= !benchmarkFile(*J, **Pipeline, File, Rng, Results);
+
+  std::error_code EC;
+  ToolOutputFile Out(OutputFile, EC, sys::fs::OF_Text);
+  if (EC) {
+    reportError(OutputFile, EC.message());
+    return 1;
+  }
+  writeReport(Out.os(), Results);
+  Out.keep();
+
+  unsigned NumMismatches = count_if(Results, [](const FunctionResult &R) {
+    return R.Status == "mismatch" || R.Status == "timeout";
+  });
+  for (const FunctionResult &R : Results) {
+    if (R.Status == "mismatch")
+      reportError(R.File, R.Name + ": different results on input " + Twine(R.MismatchInput));
+    else if (R.Status == "timeout")
+      reportError(R.File, R.Name + ": the optimized version does not finish on input " + Twine(R.MismatchInput));
+  }
+  return Failed || NumMismatches ? 1 : 0;
+}
@@ -0,0 +1,351 @@
+// Compile-time scalability benchmark of the passes, on synthetic modules:
+//
+//   compile-bench -sweep=loops -sizes=10,100,1000,10000 -o loops.json
+//
+// The module of every size is the one of the -gen-* options (see ir-gen),
+// with the swept parameter set to that size, and its loops rotated (-prepare).
+// Every pass (-passes, by default each pass of the plugin alone) runs on it in
+// a child process: the report gives the wall time of the pipeline, the peak
+// memory of the child and the one of a child that only prepares the module.
+// The growth exponent of a pass is the slope of log(time) over
+// log(instructions); with -max-exponent the exit status is 1 when one is
+// above it.
+#include "IRGenerator.h"
+#include "Pipeline.h"
+
+#include "llvm/ADT/StringExtras.h"
+#include "llvm/IR/LLVMContext.h"
+#include "llvm/IR/Verifier.h"
+#include "llvm/Support/CommandLine.h"
+#include "llvm/Support/FileSystem.h"
+#include "llvm/Support/FileUtilities.h"
+#include "llvm/Support/Format.h"
+#include "llvm/Support/FormatVariadic.h"
+#include "llvm/Support/InitLLVM.h"
+#include "llvm/Support/JSON.h"
+#include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Support/Program.h"
+#include "llvm/Support/ToolOutputFile.h"
+#include "llvm/Support/WithColor.h"
+
+#include <chrono>
+#include <cmath>
+#include <optional>
+using namespace llvm;
+
+namespace {
+enum class SweepKind { Loops, Body, Depth, Functions };
+}
+
+// -sizes and -o are checked in main, as the children do not take them
+static cl::opt<SweepKind> Sweep("sweep", cl::init(SweepKind::Loops), cl::desc("Parameter to grow"),
+    cl::values(clEnumValN(SweepKind::Loops, "loops", "Loop nests per function (-gen-loops)"),
+               clEnumValN(SweepKind::Body, "body", "Instructions per loop body (-gen-body)"),
+               clEnumValN(SweepKind::Depth, "depth", "Nesting depth (-gen-depth)"),
+               clEnumValN(SweepKind::Functions, "functions", "Functions (-gen-functions)")));
+static cl::list<unsigned> Sizes("sizes", cl::CommaSeparated,
+    cl::desc("Values of the swept parameter, in increasing order"));
+static cl::list<std::string> Passes("passes",
+    cl::desc("Pipeline to time, in the syntax of opt -passes (repeatable; "
+             "default: every pass of the plugin alone)"));
+static cl::opt<std::string> Prepare("prepare", cl::init("loop-simplify,loop-rotate,lcssa"),
+    cl::desc("Untimed pipeline that brings the loops to the form the passes expect"));
+static cl::opt<std::string> OutputFile("o", cl::value_desc("file"),
+    cl::desc("JSON report"));
+static cl::opt<unsigned> Repeat("repeat", cl::init(3),
+    cl::desc("Runs of every point: the minimum time and memory are kept"));
+static cl::opt<unsigned> Timeout("timeout", cl::init(600),
+    cl::desc("Seconds a run may take; the larger sizes of a pass that times out are skipped"));
+static cl::opt<double> MaxExponent("max-exponent", cl::init(0),
+    cl::desc("Fail when a growth exponent is above this (0: never)"));
+
+// Run of one point, in the child process
+static cl::opt<bool> Child("child", cl::Hidden);
+static cl::opt<std::string> ChildPasses("child-passes", cl::Hidden);
+static cl::opt<std::string> ChildOutput("child-output", cl::Hidden);
+
+static ExitOnError ExitOnErr;
+
+static const char *DefaultPasses[] = {
+  "local-opts", "SCCP-opt", "VBE-hoist", "LICM-opt",
+  "LoopUnswitch-opt", "LoopFusion-opt", "LoopDeletion-opt", "IVSR-opt",
+};
+
+namespace {
+
+struct Measure {
+  double Seconds = 0;
+  uint64_t Instructions = 0;
+  uint64_t PeakKiB = 0;
+};
+
+struct Point {
+  unsigned Size;
+  Measure M;
+  uint64_t BaselinePeakKiB;
+};
+
+struct PassResult {
+  std::string Pipeline;
+  std::vector<Point> Points;
+  std::string Error;
+};
+
+}
+
+static void reportError(const Twine &Msg) {
+  WithColor::error(errs(), "compile-bench") << Msg << "\n";
+}
+
+// Generates the module, prepares it, runs ChildPasses on it and writes the
+// time and the instructions of the input to ChildOutput
+static int runChild() {
+  LLVMContext Ctx;
+  std::unique_ptr<Module> M = generateModule(Ctx, IRGenOptions::fromCommandLine());
+  if (!Prepare.empty()) ExitOnErr(OptPipeline::create(Prepare))->run(*M);
+  unsigned Instructions = M->getInstructionCount();
+
+  double Seconds = 0;
+  if (!ChildPasses.empty()) {
+    std::unique_ptr<OptPipeline> Pipeline = ExitOnErr(OptPipeline::create(ChildPasses));
+    auto Start = std::chrono::steady_clock::now();
+    Pipeline->run(*M);
+    Seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - Start).count();
+
+    if (verifyModule(*M, &errs())) {
+      reportError(ChildPasses + ": optimized module is broken");
+      return 1;
+    }
+  }
+
+  std::error_code EC;
+  raw_fd_ostream Out(ChildOutput, EC, sys::fs::OF_Text);
+  if (EC) {
+    reportError(ChildOutput + ": " + EC.message());
+    return 1;
+  }
+  Out << format("%.9f %u\n", Seconds, Instructions);
+  return 0;
+}
+
+static IRGenOptions getPointOptions(const IRGenOptions &Base, unsigned Size) {
+  IRGenOptions Opts = Base;
+  switch (Sweep) {
+    case SweepKind::Loops: Opts.NumLoops = Size; break;
+    case SweepKind::Body: Opts.BodySize = Size; break;
+    case SweepKind::Depth: Opts.Depth = Size; break;
+    case SweepKind::Functions: Opts.NumFunctions = Size; break;
+  }
+  return Opts;
+}
+
+// Runs a child on the module of Opts; an empty pipeline only generates it
+static Expected<Measure> runPoint(StringRef Executable, const IRGenOptions &Opts, StringRef Pipeline) {
+  SmallString<128> OutputPath, ErrorPath;
+  if (std::error_code EC = sys::fs::createTemporaryFile("compile-bench", "txt", OutputPath))
+    return createStringError(EC, "cannot create a temporary file");
+  FileRemover OutputRemover(OutputPath);
+  if (std::error_code EC = sys::fs::createTemporaryFile("compile-bench", "err", ErrorPath))
+    return createStringError(EC, "cannot create a temporary file");
+  FileRemover ErrorRemover(ErrorPath);
+
+  std::vector<std::string> Args = {
+    Executable.str(), "-child",
+    "-child-passes=" + Pipeline.str(),
+    "-prepare=" + Prepare,
+    "-child-output=" + OutputPath.str().str(),
+    formatv("-gen-functions={0}", Opts.NumFunctions).str(),
+    formatv("-gen-loops={0}", Opts.NumLoops).str(),
+    formatv("-gen-body={0}", Opts.BodySize).str(),
+    formatv("-gen-depth={0}", Opts.Depth).str(),
+    formatv("-gen-fusable={0}", Opts.FusableDensity).str(),
+    formatv("-gen-invariant={0}", Opts.InvariantDensity).str(),
+    formatv("-gen-seed={0}", Opts.Seed).str(),
+  };
+  SmallVector<StringRef> ArgRefs(Args.begin(), Args.end());
+  // The traces of the passes go to /dev/null, the errors are kept for the report
+  std::optional<StringRef> Redirects[] = {std::nullopt, StringRef(""), StringRef(ErrorPath)};
+
+  std::string ErrMsg;
+  std::optional<sys::ProcessStatistics> Stats;
+  int Status = sys::ExecuteAndWait(Executable, ArgRefs, std::nullopt, Redirects,
+                                   Timeout, /*MemoryLimit=*/0, &ErrMsg, nullptr, &Stats);
+  if (Status != 0) {
+    if (ErrMsg.empty()) {
+      ErrMsg = "exit status " + std::to_string(Status);
+      if (ErrorOr<std::unique_ptr<MemoryBuffer>> Errors = MemoryBuffer::getFile(ErrorPath)) {
+        StringRef Text = (*Errors)->getBuffer().rtrim();
+        StringRef LastLine = Text.substr(Text.rfind('\n') + 1);
+        if (!LastLine.empty()) ErrMsg += ": " + LastLine.str();
+      }
+    }
+    return createStringError(inconvertibleErrorCode(), ErrMsg);
+  }
+
+  ErrorOr<std::unique_ptr<MemoryBuffer>> Output = MemoryBuffer::getFile(OutputPath);
+  if (!Output) return createStringError(Output.getError(), "cannot read the child output");
+
+  Measure M;
+  auto [SecondsText, InstructionsText] = (*Output)->getBuffer().trim().split(' ');
+  if (SecondsText.getAsDouble(M.Seconds) || InstructionsText.getAsInteger(10, M.Instructions))
+    return createStringError(inconvertibleErrorCode(), "malformed child output");
+  if (Stats) M.PeakKiB = Stats->PeakMemory;
+  return M;
+}
+
+// The minimum of Repeat runs
+static Expected<Measure> measurePoint(StringRef Executable, const IRGenOptions &Opts, StringRef Pipeline) {
+  Measure Best;
+  for (unsigned i = 0; i < std::max(1u, unsigned(Repeat)); ++i) {
+    Expected<Measure> M = runPoint(Executable, Opts, Pipeline);
+    if (!M) return M.takeError();
+    if (i == 0 || M->Seconds < Best.Seconds) Best.Seconds = M->Seconds;
+    if (i == 0 || M->PeakKiB < Best.PeakKiB) Best.PeakKiB = M->PeakKiB;
+    Best.Instructions = M->Instructions;
+  }
+  return Best;
+}
+
+// Least-squares slope of log(seconds) over log(instructions)
+static std::optional<double> getGrowthExponent(ArrayRef<Point> Points) {
+  double SumX = 0, SumY = 0, SumXX = 0, SumXY = 0;
+  unsigned N = 0;
+  for (const Point &P : Points) {
+    if (P.M.Seconds <= 0 || P.M.Instructions == 0) continue;
+    double X = std::log(double(P.M.Instructions)), Y = std::log(P.M.Seconds);
+    SumX += X;
+    SumY += Y;
+    SumXX += X * X;
+    SumXY += X * Y;
+    ++N;
+  }
+  double Den = N * SumXX - SumX * SumX;
+  if (N < 2 || Den <= 0) return std::nullopt;
+  return (N * SumXY - SumX * SumY) / Den;
+}
+
+static StringRef getSweepName() {
+  switch (Sweep) {
+    case SweepKind::Loops: return "loops";
+    case SweepKind::Body: return "body";
+    case SweepKind::Depth: return "depth";
+    case SweepKind::Functions: return "functions";
+  }
+  llvm_unreachable("unknown sweep");
+}
+
+static void writeReport(raw_ostream &OS, const IRGenOptions &Base, ArrayRef<PassResult> Results) {
+  json::OStream J(OS, 2);
+  J.object([&] {
+    J.attribute("sweep", getSweepName());
+    J.attributeObject("base", [&] {
+      J.attribute("functions", Base.NumFunctions);
+      J.attribute("loops", Base.NumLoops);
+      J.attribute("body", Base.BodySize);
+      J.attribute("depth", Base.Depth);
+      J.attribute("fusable", Base.FusableDensity);
+      J.attribute("invariant", Base.InvariantDensity);
+      J.attribute("seed", Base.Seed);
+    });
+    J.attributeArray("passes", [&] {
+      for (const PassResult &R : Results) {
+        J.object([&] {
+          J.attribute("pipeline", R.Pipeline);
+          if (std::optional<double> Exponent = getGrowthExponent(R.Points))
+            J.attribute("exponent", *Exponent);
+          else
+            J.attribute("exponent", nullptr);
+          if (!R.Error.empty()) J.attribute("error", R.Error);
+          J.attributeArray("points", [&] {
+            for (const Point &P : R.Points) {
+              J.object([&] {
+                J.attribute("size", P.Size);
+                J.attribute("instructions", P.M.Instructions);
+                J.attribute("seconds", P.M.Seconds);
+                J.attribute("peak_kib", P.M.PeakKiB);
+                J.attribute("baseline_peak_kib", P.BaselinePeakKiB);
+              });
+            }
+          });
+        });
+      }
+    });
+  });
+  OS << "\n";
+}
+
+int main(int argc, char **argv) {
+  InitLLVM X(argc, argv);
+  cl::ParseCommandLineOptions(argc, argv, "Compile-time benchmark of the passes on synthetic IR\n");
+  ExitOnErr.setBanner("compile-bench: ");
+  if (Child) return runChild();
+  if (Sizes.empty() || OutputFile.empty()) {
+    reportError("-sizes and -o are required");
+    return 1;
+  }
+
+  std::string Executable = sys::fs::getMainExecutable(argv[0], (void*)&runChild);
+  IRGenOptions Base = IRGenOptions::fromCommandLine();
+
+  SmallVector<std::string> Pipelines(Passes.begin(), Passes.end());
+  if (Pipelines.empty()) Pipelines.assign(std::begin(DefaultPasses), std::end(DefaultPasses));
+  if (!Prepare.empty()) {
+    if (Expected<std::unique_ptr<OptPipeline>> P = OptPipeline::create(Prepare); !P) {
+      reportError("-prepare=" + Prepare + ": " + toString(P.takeError()));
+      return 1;
+    }
+  }
+  for (const std::string &Pipeline : Pipelines) {
+    if (Expected<std::unique_ptr<OptPipeline>> P = OptPipeline::create(Pipeline); !P) {
+      reportError("-passes=" + Pipeline + ": " + toString(P.takeError()));
+      return 1;
+    }
+  }
+
+  std::vector<uint64_t> BaselinePeaks;
+  for (unsigned Size : Sizes) {
+    Expected<Measure> M = measurePoint(Executable, getPointOptions(Base, Size), "");
+    if (!M) {
+      reportError(formatv("size {0}: {1}", Size, toString(M.takeError())));
+      return 1;
+    }
+    BaselinePeaks.push_back(M->PeakKiB);
+  }
+
+  std::vector<PassResult> Results;
+  for (const std::string &Pipeline : Pipelines) {
+    PassResult &R = Results.emplace_back();
+    R.Pipeline = Pipeline;
+    for (auto [Size, BaselinePeak] : zip(Sizes, BaselinePeaks)) {
+      Expected<Measure> M = measurePoint(Executable, getPointOptions(Base, Size), Pipeline);
+      if (!M) {
+        R.Error = formatv("size {0}: {1}", Size, toString(M.takeError())).str();
+        reportError(Pipeline + ": " + R.Error);
+        break;
+      }
+      R.Points.push_back({Size, *M, BaselinePeak});
+      outs() << formatv("{0,-20} {1,8} {2,10} instructions {3,10:f4} s {4,8} KiB\n",
+                        Pipeline, Size, M->Instructions, M->Seconds, M->PeakKiB);
+    }
+  }
+
+  std::error_code EC;
+  ToolOutputFile Out(OutputFile, EC, sys::fs::OF_Text);
+  if (EC) {
+    reportError(OutputFile + ": " + EC.message());
+    return 1;
+  }
+  writeReport(Out.os(), Base, Results);
+  Out.keep();
+
+  bool Failed = any_of(Results, [](const PassResult &R) { return !R.Error.empty(); });
+  for (const PassResult &R : Results) {
+    std::optional<double> Exponent = getGrowthExponent(R.Points);
+    if (MaxExponent > 0 && Exponent && *Exponent > MaxExponent) {
+      reportError(formatv("{0}: grows as instructions^{1:f2}, above -max-exponent={2}",
+                          R.Pipeline, *Exponent, MaxExponent.getValue()));
+      Failed = true;
+    }
+  }
+  return Failed ? 1 : 0;
+}
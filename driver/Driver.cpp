@@ -0,0 +1,329 @@
+// Batch optimizer: runs one pass pipeline on many IR files in a single
+// process, in parallel.
+//
+//   opt-driver -passes="mem2reg,loop-simplify,loop-rotate,LICM-opt" -j 8 \
+//              -output-dir test/ll_opt -S test/ll/*.ll
+//
+// Every worker thread owns a copy of the pipeline, and takes the next input
+// file until none is left. Each file is read in a new LLVMContext: the bitcode
+// lists the metadata kinds of the context, which must not depend on the files
+// a worker read before.
+//
+// With -split-module the inputs are optimized one at a time, and the functions
+// of each module are spread over the workers instead (see SplitOptimizer).
+// With -cache-dir too, the optimized functions are kept on disk: the next runs
+// only optimize the functions that changed.
+//
+// The passes report what they did through statistics (-stats), optimization
+// remarks (-pass-remarks=<regex> on the console, -remarks-dir for one file per
+// input) and time trace entries (-time-trace).
+#include "FunctionCache.h"
+#include "Pipeline.h"
+#include "SplitOptimizer.h"
+
+#include "llvm/ADT/ScopeExit.h"
+#include "llvm/ADT/StringExtras.h"
+#include "llvm/Bitcode/BitcodeWriter.h"
+#include "llvm/Config/llvm-config.h"
+#include "llvm/IR/LLVMContext.h"
+#include "llvm/IR/LLVMRemarkStreamer.h"
+#include "llvm/IR/Verifier.h"
+#include "llvm/IRReader/IRReader.h"
+#include "llvm/Remarks/RemarkStreamer.h"
+#include "llvm/Support/CommandLine.h"
+#include "llvm/Support/FileSystem.h"
+#include "llvm/Support/Format.h"
+#include "llvm/Support/InitLLVM.h"
+#include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Support/Path.h"
+#include "llvm/Support/SHA1.h"
+#include "llvm/Support/SourceMgr.h"
+#include "llvm/Support/ThreadPool.h"
+#include "llvm/Support/Threading.h"
+#include "llvm/Support/TimeProfiler.h"
+#include "llvm/Support/ToolOutputFile.h"
+#include "llvm/Support/WithColor.h"
+
+#include <atomic>
+#include <chrono>
+#include <mutex>
+using namespace llvm;
+
+static cl::list<std::string> InputFiles(cl::Positional, cl::OneOrMore,
+    cl::desc("<input .ll/.bc files>"));
+static cl::opt<std::string> PassPipeline("passes", cl::init("default<O2>"),
+    cl::desc("Pipeline to run, in the syntax of opt -passes"));
+static cl::opt<unsigned> Jobs("j", cl::init(0),
+    cl::desc("Worker threads (0 = one per hardware thread)"));
+static cl::opt<std::string> OutputDir("output-dir",
+    cl::desc("Write <name>.opt.bc (or .opt.ll with -S) to this directory; "
+             "nothing is written by default"));
+static cl::opt<bool> OutputAssembly("S",
+    cl::desc("Write textual IR instead of bitcode"));
+static cl::opt<bool> DisableVerify("disable-verify",
+    cl::desc("Do not verify the optimized modules"));
+static cl::opt<bool> SplitModule("split-module",
+    cl::desc("Optimize the functions of each module in parallel "
+             "(-passes must be a function pipeline)"));
+static cl::opt<unsigned> SplitPartitions("split-partitions", cl::init(0),
+    cl::desc("Partitions of each module with -split-module (0 = four per worker)"));
+static cl::opt<bool> CheckSplit("check-split",
+    cl::desc("With -split-module, optimize each input as without it too, and "
+             "fail if the two outputs differ"));
+static cl::opt<std::string> CacheDir("cache-dir",
+    cl::desc("Reuse the functions optimized by the previous runs, kept in "
+             "this directory (implies -split-module)"));
+static cl::opt<std::string> RemarksDir("remarks-dir",
+    cl::desc("Write the optimization remarks of every input to "
+             "<name>.opt.yaml (or .opt.bitstream) in this directory"));
+static cl::opt<std::string> RemarksFormat("remarks-format", cl::init("yaml"),
+    cl::desc("Format of the remarks of -remarks-dir: yaml or bitstream"));
+static cl::opt<std::string> RemarksFilter("remarks-filter",
+    cl::desc("Only write the remarks of the passes matching this regex"));
+static cl::opt<bool> TimeTrace("time-trace",
+    cl::desc("Write a Chrome trace of the files, passes and analyses of every worker"));
+static cl::opt<unsigned> TimeTraceGranularity("time-trace-granularity", cl::init(500),
+    cl::desc("Minimum duration of a trace entry, in microseconds"));
+static cl::opt<std::string> TimeTraceFile("time-trace-file",
+    cl::desc("Output of -time-trace (default: opt-driver.time-trace)"));
+
+static std::mutex DiagMutex;
+
+static void reportError(StringRef File, const Twine &Msg) {
+  std::lock_guard<std::mutex> Lock(DiagMutex);
+  WithColor::error(errs(), "opt-driver") << File << ": " << Msg << "\n";
+}
+
+static bool writeModule(Module &M, StringRef InputFile) {
+  SmallString<128> Path(OutputDir);
+  sys::path::append(Path, sys::path::stem(InputFile) + (OutputAssembly ? ".opt.ll" : ".opt.bc"));
+
+  std::error_code EC;
+  ToolOutputFile Out(Path, EC, OutputAssembly ? sys::fs::OF_Text : sys::fs::OF_None);
+  if (EC) {
+    reportError(Path, EC.message());
+    return false;
+  }
+
+  if (OutputAssembly) M.print(Out.os(), nullptr);
+  else WriteBitcodeToFile(M, Out.os());
+  Out.keep();
+  return true;
+}
+
+static bool optimizeFile(StringRef File, LLVMContext &Ctx, function_ref<Error(Module&)> Optimize) {
+  TimeTraceScope Scope("OptimizeFile", File);
+
+  // Ctx outlives this call: its remark streamer must go before the file it
+  // writes to
+  std::unique_ptr<ToolOutputFile> RemarksFile;
+  auto ResetRemarks = make_scope_exit([&] {
+    Ctx.setLLVMRemarkStreamer(nullptr);
+    Ctx.setMainRemarkStreamer(nullptr);
+  });
+  if (!RemarksDir.empty()) {
+    SmallString<128> Path(RemarksDir);
+    sys::path::append(Path, sys::path::stem(File) + ".opt." + RemarksFormat);
+    Expected<std::unique_ptr<ToolOutputFile>> Remarks =
+        setupLLVMOptimizationRemarks(Ctx, Path, RemarksFilter, RemarksFormat, /*RemarksWithHotness=*/false);
+    if (!Remarks) {
+      reportError(Path, toString(Remarks.takeError()));
+      return false;
+    }
+    RemarksFile = std::move(*Remarks);
+  }
+
+  SMDiagnostic Diag;
+  std::unique_ptr<Module> M = parseIRFile(File, Diag, Ctx);
+  if (!M) {
+    std::lock_guard<std::mutex> Lock(DiagMutex);
+    Diag.print("opt-driver", errs());
+    return false;
+  }
+
+  if (Error Err = Optimize(*M)) {
+    reportError(File, toString(std::move(Err)));
+    return false;
+  }
+
+  if (RemarksFile) RemarksFile->keep();
+
+  std::string VerifyErrors;
+  raw_string_ostream VerifyOS(VerifyErrors);
+  if (!DisableVerify && verifyModule(*M, &VerifyOS)) {
+    reportError(File, "broken module after optimization\n" + VerifyOS.str());
+    return false;
+  }
+
+  return OutputDir.empty() || writeModule(*M, File);
+}
+
+// The bitcode writer lists the local names of a function in the order of its
+// symbol table: rebuilt as the split runs do when they link the bodies back,
+// so that the output does not depend on -split-module
+static void optimizeWhole(OptPipeline &Pipeline, Module &M) {
+  Pipeline.run(M);
+  SplitOptimizer::rebuildSymbolTables(M);
+}
+
+static SmallVector<char, 0> writeBitcode(const Module &M) {
+  SmallVector<char, 0> Bitcode;
+  raw_svector_ostream OS(Bitcode);
+  WriteBitcodeToFile(M, OS);
+  return Bitcode;
+}
+
+// The passes are linked into the driver: the hash of its executable changes
+// with any of them, where the plugin version does not
+static Expected<std::string> getDriverHash(const char *Argv0) {
+  std::string Path = sys::fs::getMainExecutable(Argv0, reinterpret_cast<void*>(&getDriverHash));
+  ErrorOr<std::unique_ptr<MemoryBuffer>> Binary =
+      MemoryBuffer::getFile(Path, /*IsText=*/false, /*RequiresNullTerminator=*/false);
+  if (!Binary) return createFileError(Path, Binary.getError());
+  return toHex(SHA1::hash(arrayRefFromStringRef((*Binary)->getBuffer())));
+}
+
+// Optimizes the inputs one at a time, each split across the workers
+static unsigned optimizeSplit(DefaultThreadPool &Pool, unsigned NumWorkers, FunctionCache *Cache) {
+  unsigned NumPartitions = SplitPartitions ? SplitPartitions : 4 * NumWorkers;
+  SplitOptimizer Splitter(PassPipeline, Pool, NumPartitions, Cache);
+  unsigned NumFailed = 0;
+
+  for (const std::string &File : InputFiles) {
+    LLVMContext Ctx;
+    bool Optimized = optimizeFile(File, Ctx, [&](Module &M) -> Error {
+      if (Error Err = Splitter.run(M)) return Err;
+      if (!CheckSplit) return Error::success();
+
+      LLVMContext SerialCtx;
+      SMDiagnostic Diag;
+      std::unique_ptr<Module> Serial = parseIRFile(File, Diag, SerialCtx);
+      if (!Serial) return createStringError(inconvertibleErrorCode(), Diag.getMessage());
+
+      // Exactly what a run without -split-module writes
+      optimizeWhole(*cantFail(OptPipeline::create(PassPipeline)), *Serial);
+      if (writeBitcode(M) != writeBitcode(*Serial))
+        return createStringError(inconvertibleErrorCode(), "split output differs from the serial run");
+      return Error::success();
+    });
+    NumFailed += !Optimized;
+  }
+  return NumFailed;
+}
+
+int main(int argc, char **argv) {
+  InitLLVM X(argc, argv);
+  cl::ParseCommandLineOptions(argc, argv, "Batch optimizer for the assignment passes\n");
+
+  if (!CacheDir.empty()) SplitModule = true;
+
+  // The workers of a split module have their own contexts and threads
+  if (SplitModule && (!RemarksDir.empty() || TimeTrace)) {
+    reportError("-split-module", "-remarks-dir and -time-trace need whole-module runs");
+    return 1;
+  }
+  if (RemarksFormat != "yaml" && RemarksFormat != "bitstream") {
+    reportError("-remarks-format", "unknown format '" + RemarksFormat + "'");
+    return 1;
+  }
+
+  // Fail early on a malformed pipeline, before any worker starts
+  if (auto P = SplitModule ? OptPipeline::createFunctionPipeline(PassPipeline)
+                           : OptPipeline::create(PassPipeline); !P) {
+    reportError("-passes", toString(P.takeError()));
+    return 1;
+  }
+
+  // The cached bodies are only valid for the same pipeline and passes
+  std::unique_ptr<FunctionCache> Cache;
+  if (!CacheDir.empty()) {
+    Expected<std::string> DriverHash = getDriverHash(argv[0]);
+    if (!DriverHash) {
+      reportError("-cache-dir", toString(DriverHash.takeError()));
+      return 1;
+    }
+    std::string Context = "passes=" + PassPipeline + " driver=" + *DriverHash + " llvm=" LLVM_VERSION_STRING;
+    Expected<std::unique_ptr<FunctionCache>> Opened = FunctionCache::open(CacheDir, Context);
+    if (!Opened) {
+      reportError(CacheDir, toString(Opened.takeError()));
+      return 1;
+    }
+    Cache = std::move(*Opened);
+  }
+
+  for (const std::string &Dir : {OutputDir.getValue(), RemarksDir.getValue()}) {
+    if (Dir.empty()) continue;
+    if (std::error_code EC = sys::fs::create_directories(Dir)) {
+      reportError(Dir, EC.message());
+      return 1;
+    }
+  }
+
+  // print-dfa writes to outs(): unbuffered, the workers do not share the
+  // stream buffer
+  outs().SetUnbuffered();
+
+  // Every worker records its own entries, merged when the trace is written
+  if (TimeTrace) timeTraceProfilerInitialize(TimeTraceGranularity, "opt-driver");
+
+  auto Start = std::chrono::steady_clock::now();
+  std::atomic<size_t> NextFile{0};
+  std::atomic<unsigned> NumFailed{0};
+
+  ThreadPoolStrategy Strategy = hardware_concurrency(Jobs);
+  unsigned NumWorkers = Strategy.compute_thread_count();
+  DefaultThreadPool Pool(Strategy);
+
+  if (SplitModule) {
+    NumFailed = optimizeSplit(Pool, NumWorkers, Cache.get());
+  } else {
+    NumWorkers = std::min<size_t>(NumWorkers, InputFiles.size());
+
+    for (unsigned i = 0; i < NumWorkers; ++i) {
+      Pool.async([&] {
+        // Before the pipeline, which only traces its passes if the thread has a profiler
+        if (TimeTrace) timeTraceProfilerInitialize(TimeTraceGranularity, "opt-driver");
+        auto FinishTrace = make_scope_exit([] {
+          if (TimeTrace) timeTraceProfilerFinishThread();
+        });
+
+        std::unique_ptr<OptPipeline> Pipeline = cantFail(OptPipeline::create(PassPipeline));
+        auto Optimize = [&](Module &M) {
+          optimizeWhole(*Pipeline, M);
+          return Error::success();
+        };
+
+        for (size_t f = NextFile++; f < InputFiles.size(); f = NextFile++) {
+          LLVMContext Ctx;
+          if (!optimizeFile(InputFiles[f], Ctx, Optimize))
+            ++NumFailed;
+        }
+      });
+    }
+    Pool.wait();
+  }
+
+  std::chrono::duration<double> Elapsed = std::chrono::steady_clock::now() - Start;
+  errs() << "Optimized " << InputFiles.size() - NumFailed << "/" << InputFiles.size()
+         << " files in " << format("%.3f", Elapsed.count()) << "s with "
+         << NumWorkers << " threads\n";
+
+  if (Cache) {
+    if (Error Err = Cache->flush()) {
+      reportError(CacheDir, toString(std::move(Err)));
+      return 1;
+    }
+    Cache->printStats(errs());
+  }
+
+  if (TimeTrace) {
+    Error Err = timeTraceProfilerWrite(TimeTraceFile, "opt-driver");
+    timeTraceProfilerCleanup();
+    if (Err) {
+      reportError("-time-trace", toString(std::move(Err)));
+      return 1;
+    }
+  }
+
+  return NumFailed ? 1 : 0;
+}
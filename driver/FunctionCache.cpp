@@ -0,0 +1,142 @@
+#include "FunctionCache.h"
+
+#include "llvm/Support/Endian.h"
+#include "llvm/Support/EndianStream.h"
+#include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Support/Path.h"
+#include "llvm/Support/SHA1.h"
+using namespace llvm;
+
+static constexpr size_t KeySize = std::tuple_size<FunctionCache::Key>::value;
+static constexpr size_t HeaderSize = KeySize + sizeof(uint64_t);
+
+static StringRef toStringRef(const FunctionCache::Key &K) {
+  return StringRef(reinterpret_cast<const char*>(K.data()), K.size());
+}
+
+// Calls Callback on every complete record of Data, and returns where the last
+// one ends
+static uint64_t scanRecords(StringRef Data, function_ref<void(StringRef, StringRef)> Callback) {
+  uint64_t Offset = 0;
+  while (Data.size() - Offset >= HeaderSize) {
+    uint64_t Size = support::endian::read64le(Data.data() + Offset + KeySize);
+    if (Data.size() - Offset - HeaderSize < Size) break;
+
+    Callback(Data.substr(Offset, KeySize), Data.substr(Offset + HeaderSize, Size));
+    Offset += HeaderSize + Size;
+  }
+  return Offset;
+}
+
+Expected<std::unique_ptr<FunctionCache>> FunctionCache::open(StringRef Dir, StringRef Context) {
+  if (std::error_code EC = sys::fs::create_directories(Dir))
+    return createFileError(Dir, EC);
+
+  SmallString<128> Path(Dir);
+  sys::path::append(Path, "functions.cache");
+  std::unique_ptr<FunctionCache> Cache(new FunctionCache(std::string(Path), Context.str()));
+  if (Error Err = Cache->map()) return std::move(Err);
+  return std::move(Cache);
+}
+
+Error FunctionCache::map() {
+  uint64_t Size;
+  if (std::error_code EC = sys::fs::file_size(Path, Size)) {
+    if (EC == std::errc::no_such_file_or_directory) return Error::success();
+    return createFileError(Path, EC);
+  }
+  // An empty file cannot be mapped
+  if (Size == 0) return Error::success();
+
+  Expected<sys::fs::file_t> File = sys::fs::openNativeFileForRead(Path);
+  if (!File) return createFileError(Path, File.takeError());
+
+  std::error_code EC;
+  Mapped = std::make_unique<sys::fs::mapped_file_region>(*File, sys::fs::mapped_file_region::readonly, Size, 0, EC);
+  sys::fs::closeFile(*File);
+  if (EC) return createFileError(Path, EC);
+
+  scanRecords(StringRef(Mapped->const_data(), Mapped->size()), [&](StringRef K, StringRef Bitcode) {
+    Entries.try_emplace(K, Bitcode);
+  });
+  return Error::success();
+}
+
+FunctionCache::Key FunctionCache::getKey(StringRef Fingerprint) const {
+  SHA1 Hasher;
+  Hasher.update(Context);
+  Hasher.update(StringRef("\0", 1));
+  Hasher.update(Fingerprint);
+  return Hasher.final();
+}
+
+std::optional<StringRef> FunctionCache::lookup(const Key &K) {
+  std::optional<StringRef> Bitcode;
+  if (auto It = Entries.find(toStringRef(K)); It != Entries.end())
+    Bitcode = It->second;
+  else if (auto It = Pending.find(toStringRef(K)); It != Pending.end())
+    Bitcode = It->second;
+
+  if (!Bitcode) {
+    ++Misses;
+    return std::nullopt;
+  }
+  ++Hits;
+  BytesRead += Bitcode->size();
+  return Bitcode;
+}
+
+void FunctionCache::insert(const Key &K, StringRef Bitcode) {
+  if (Entries.count(toStringRef(K))) return;
+  Pending.try_emplace(toStringRef(K), Bitcode.str());
+}
+
+Error FunctionCache::flush() {
+  if (Pending.empty()) return Error::success();
+
+  int FD;
+  if (std::error_code EC = sys::fs::openFileForReadWrite(Path, FD, sys::fs::CD_OpenAlways, sys::fs::OF_None))
+    return createFileError(Path, EC);
+  raw_fd_ostream OS(FD, /*shouldClose=*/true);
+  if (std::error_code EC = sys::fs::lockFile(FD))
+    return createFileError(Path, EC);
+
+  // Another driver may have appended since the file was mapped: the new
+  // records go after the last complete one
+  ErrorOr<std::unique_ptr<MemoryBuffer>> Current = MemoryBuffer::getOpenFile(
+      sys::fs::convertFDToNativeFileHandle(FD), Path, /*FileSize=*/-1, /*RequiresNullTerminator=*/false);
+  if (!Current) {
+    sys::fs::unlockFile(FD);
+    return createFileError(Path, Current.getError());
+  }
+  uint64_t End = scanRecords((*Current)->getBuffer(), [](StringRef, StringRef) {});
+  if (End != (*Current)->getBufferSize()) {
+    if (std::error_code EC = sys::fs::resize_file(FD, End)) {
+      sys::fs::unlockFile(FD);
+      return createFileError(Path, EC);
+    }
+  }
+
+  OS.seek(End);
+  for (const auto &Entry : Pending) {
+    OS << Entry.getKey();
+    support::endian::write<uint64_t>(OS, Entry.getValue().size(), llvm::endianness::little);
+    OS << Entry.getValue();
+    BytesWritten += Entry.getValue().size();
+  }
+  OS.flush();
+  sys::fs::unlockFile(FD);
+  Pending.clear();
+
+  if (OS.has_error()) {
+    std::error_code EC = OS.error();
+    OS.clear_error();
+    return createFileError(Path, EC);
+  }
+  return Error::success();
+}
+
+void FunctionCache::printStats(raw_ostream &OS) const {
+  OS << "Function cache: " << Hits << " hits, " << Misses << " misses, "
+     << BytesRead << " bytes read, " << BytesWritten << " bytes written\n";
+}
@@ -0,0 +1,57 @@
+#ifndef FUNCTION_CACHE_H
+#define FUNCTION_CACHE_H
+
+#include "llvm/ADT/StringMap.h"
+#include "llvm/Support/Error.h"
+#include "llvm/Support/FileSystem.h"
+#include "llvm/Support/raw_ostream.h"
+
+#include <array>
+#include <memory>
+#include <optional>
+#include <string>
+
+namespace llvm {
+
+// On-disk store of optimized function bodies, keyed by the SHA-1 of the
+// function before the pipeline. The store is one append-only file of records
+//   [20-byte key][64-bit little-endian size][bitcode]
+// mapped in memory when the cache is opened. The entries added by a run are
+// appended by flush, under a file lock, so that concurrent drivers can share
+// a cache directory. An incomplete record at the end (a killed driver) is
+// ignored, and cut off by the next flush.
+class FunctionCache {
+    public:
+        using Key = std::array<uint8_t, 20>;
+
+        // Context names what produced the bodies (pipeline, plugin and LLVM
+        // versions): it is part of every key
+        static Expected<std::unique_ptr<FunctionCache>> open(StringRef Dir, StringRef Context);
+
+        // Key of a function described by Fingerprint (see SplitOptimizer)
+        Key getKey(StringRef Fingerprint) const;
+
+        // Bitcode stored for K, in the mapped file; counts a hit or a miss
+        std::optional<StringRef> lookup(const Key &K);
+        // Copies Bitcode, written to disk by flush
+        void insert(const Key &K, StringRef Bitcode);
+        Error flush();
+
+        void printStats(raw_ostream &OS) const;
+
+    private:
+        FunctionCache(std::string Path, std::string Context) : Path(std::move(Path)), Context(std::move(Context)) {}
+        Error map();
+
+        std::string Path;
+        std::string Context;
+        std::unique_ptr<sys::fs::mapped_file_region> Mapped;
+        // Key bytes -> bitcode in Mapped, and the entries not written yet
+        StringMap<StringRef> Entries;
+        StringMap<std::string> Pending;
+
+        uint64_t Hits = 0, Misses = 0, BytesRead = 0, BytesWritten = 0;
+};
+}
+
+#endif
@@ -0,0 +1,43 @@
+// Writes a synthetic module in the shape of the -gen-* options, for the
+// passes and opt:
+//
+//   ir-gen -gen-loops=100 -gen-body=20 -gen-depth=2 -o synthetic.ll
+#include "IRGenerator.h"
+
+#include "llvm/Bitcode/BitcodeWriter.h"
+#include "llvm/IR/Verifier.h"
+#include "llvm/Support/CommandLine.h"
+#include "llvm/Support/FileSystem.h"
+#include "llvm/Support/InitLLVM.h"
+#include "llvm/Support/ToolOutputFile.h"
+#include "llvm/Support/WithColor.h"
+using namespace llvm;
+
+static cl::opt<std::string> OutputFile("o", cl::init("-"), cl::value_desc("file"),
+    cl::desc("Output file, bitcode if it ends in .bc"));
+
+int main(int argc, char **argv) {
+  InitLLVM X(argc, argv);
+  cl::ParseCommandLineOptions(argc, argv, "Synthetic IR generator for the assignment passes\n");
+
+  LLVMContext Ctx;
+  std::unique_ptr<Module> M = generateModule(Ctx, IRGenOptions::fromCommandLine());
+  if (verifyModule(*M, &errs())) {
+    WithColor::error(errs(), "ir-gen") << "generated module is broken\n";
+    return 1;
+  }
+
+  bool Bitcode = StringRef(OutputFile).ends_with(".bc");
+  std::error_code EC;
+  ToolOutputFile Out(OutputFile, EC, Bitcode ? sys::fs::OF_None : sys::fs::OF_Text);
+  if (EC) {
+    WithColor::error(errs(), "ir-gen") << OutputFile << ": " << EC.message() << "\n";
+    return 1;
+  }
+  if (Bitcode)
+    WriteBitcodeToFile(*M, Out.os());
+  else
+    M->print(Out.os(), nullptr);
+  Out.keep();
+  return 0;
+}
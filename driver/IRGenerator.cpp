@@ -0,0 +1,173 @@
+#include "IRGenerator.h"
+
+#include "llvm/IR/IRBuilder.h"
+#include "llvm/Support/CommandLine.h"
+
+#include <random>
+using namespace llvm;
+
+static cl::OptionCategory GenCategory("IR generator options");
+static cl::opt<unsigned> GenFunctions("gen-functions", cl::init(1), cl::cat(GenCategory),
+    cl::desc("Functions of the synthetic module"));
+static cl::opt<unsigned> GenLoops("gen-loops", cl::init(10), cl::cat(GenCategory),
+    cl::desc("Loop nests of every function"));
+static cl::opt<unsigned> GenBody("gen-body", cl::init(10), cl::cat(GenCategory),
+    cl::desc("Arithmetic instructions of every loop body"));
+static cl::opt<unsigned> GenDepth("gen-depth", cl::init(1), cl::cat(GenCategory),
+    cl::desc("Nesting depth of the loop nests"));
+static cl::opt<double> GenFusable("gen-fusable", cl::init(0.5), cl::cat(GenCategory),
+    cl::desc("Fraction of adjacent loops with the same trip count"));
+static cl::opt<double> GenInvariant("gen-invariant", cl::init(0.2), cl::cat(GenCategory),
+    cl::desc("Fraction of loop-invariant body instructions"));
+static cl::opt<unsigned> GenSeed("gen-seed", cl::init(1), cl::cat(GenCategory),
+    cl::desc("Seed of the generator"));
+
+IRGenOptions IRGenOptions::fromCommandLine() {
+  IRGenOptions Opts;
+  Opts.NumFunctions = GenFunctions;
+  Opts.NumLoops = GenLoops;
+  Opts.BodySize = GenBody;
+  Opts.Depth = std::max(1u, unsigned(GenDepth));
+  Opts.FusableDensity = GenFusable;
+  Opts.InvariantDensity = GenInvariant;
+  Opts.Seed = GenSeed;
+  return Opts;
+}
+
+namespace {
+
+// Emits the loop nests of one function
+class FunctionGenerator {
+  public:
+    FunctionGenerator(Function &F, const IRGenOptions &Opts, std::mt19937 &Rng)
+        : F(F), Opts(Opts), Rng(Rng), Builder(F.getContext()) {}
+
+    void run();
+
+  private:
+    // True with probability P; std::mt19937 gives the same sequence everywhere
+    bool chance(double P) { return Rng() % 1000000 < P * 1000000; }
+    unsigned pick(unsigned N) { return Rng() % N; }
+
+    // Loop of the given nesting level, from the current block: the builder
+    // ends in its exit block
+    void emitLoop(unsigned Level, Value *Bound);
+    // Loads src[IV], runs it through BodySize instructions, stores it to dst[IV]
+    void emitBody(Value *IV);
+
+    Function &F;
+    const IRGenOptions &Opts;
+    std::mt19937 &Rng;
+    IRBuilder<> Builder;
+    Value *Src, *Dst, *X, *Y;
+};
+
+}
+
+void FunctionGenerator::run() {
+  Src = F.getArg(0);
+  Dst = F.getArg(1);
+  Value *N = F.getArg(2), *M = F.getArg(3);
+  X = F.getArg(4);
+  Y = F.getArg(5);
+
+  Builder.SetInsertPoint(BasicBlock::Create(F.getContext(), "entry", &F));
+  Value *Bound = N;
+  for (unsigned i = 0; i < Opts.NumLoops; ++i) {
+    if (i > 0 && !chance(Opts.FusableDensity))
+      Bound = Bound == N ? M : N;
+    emitLoop(0, Bound);
+  }
+  Builder.CreateRetVoid();
+}
+
+void FunctionGenerator::emitLoop(unsigned Level, Value *Bound) {
+  LLVMContext &Ctx = F.getContext();
+  BasicBlock *Preheader = Builder.GetInsertBlock();
+  BasicBlock *Header = BasicBlock::Create(Ctx, "for.cond", &F);
+  BasicBlock *Body = BasicBlock::Create(Ctx, "for.body", &F);
+  BasicBlock *Exit = BasicBlock::Create(Ctx, "for.end");
+  Builder.CreateBr(Header);
+
+  Builder.SetInsertPoint(Header);
+  PHINode *IV = Builder.CreatePHI(Builder.getInt32Ty(), 2, "i");
+  IV->addIncoming(Builder.getInt32(0), Preheader);
+  Builder.CreateCondBr(Builder.CreateICmpSLT(IV, Bound, "cmp"), Body, Exit);
+
+  Builder.SetInsertPoint(Body);
+  emitBody(IV);
+  if (Level + 1 < Opts.Depth) emitLoop(Level + 1, Bound);
+
+  BasicBlock *Latch = BasicBlock::Create(Ctx, "for.inc", &F);
+  Builder.CreateBr(Latch);
+  Builder.SetInsertPoint(Latch);
+  IV->addIncoming(Builder.CreateNSWAdd(IV, Builder.getInt32(1), "inc"), Latch);
+  Builder.CreateBr(Header);
+
+  Exit->insertInto(&F);
+  Builder.SetInsertPoint(Exit);
+}
+
+void FunctionGenerator::emitBody(Value *IV) {
+  static const Instruction::BinaryOps Opcodes[] = {
+    Instruction::Add, Instruction::Sub, Instruction::Mul,
+    Instruction::Shl, Instruction::Xor, Instruction::And,
+  };
+  // Identities and strength reductions for the local optimizations
+  static const int Constants[] = {0, 1, 2, 3, 4, 8, 15, 17, 29};
+
+  auto constant = [&](Instruction::BinaryOps Opcode) -> Value* {
+    if (Opcode == Instruction::Shl) return Builder.getInt32(1 + pick(4));
+    return Builder.getInt32(Constants[pick(std::size(Constants))]);
+  };
+
+  Type *Int32 = Builder.getInt32Ty();
+  Value *Idx = Builder.CreateSExt(IV, Builder.getInt64Ty(), "idxprom");
+  Value *Cur = Builder.CreateLoad(Int32, Builder.CreateInBoundsGEP(Int32, Src, Idx, "arrayidx"), "ld");
+
+  SmallVector<Value*> Invariants = {X, Y};
+  for (unsigned i = 0; i < Opts.BodySize; ++i) {
+    Instruction::BinaryOps Opcode = Opcodes[pick(std::size(Opcodes))];
+
+    if (chance(Opts.InvariantDensity)) {
+      Value *LHS = Invariants[pick(Invariants.size())];
+      Value *RHS = pick(2) && Opcode != Instruction::Shl ? Invariants[pick(Invariants.size())] : constant(Opcode);
+      Invariants.push_back(Builder.CreateBinOp(Opcode, LHS, RHS, "inv"));
+      continue;
+    }
+
+    // Shifts by constants only, as larger amounts are poison
+    Value *RHS;
+    switch (Opcode == Instruction::Shl ? 2 : pick(3)) {
+      case 0: RHS = IV; break;
+      case 1: RHS = Invariants[pick(Invariants.size())]; break;
+      default: RHS = constant(Opcode);
+    }
+    Cur = Builder.CreateBinOp(Opcode, Cur, RHS, "v");
+  }
+
+  // The last invariant is used, as in x = n * 2 inside a loop
+  if (Invariants.size() > 2)
+    Cur = Builder.CreateAdd(Cur, Invariants.back(), "v");
+  Builder.CreateStore(Cur, Builder.CreateInBoundsGEP(Int32, Dst, Idx, "arrayidx"));
+}
+
+std::unique_ptr<Module> llvm::generateModule(LLVMContext &Ctx, const IRGenOptions &Opts) {
+  auto M = std::make_unique<Module>("synthetic", Ctx);
+  std::mt19937 Rng(Opts.Seed);
+
+  // void synthetic(int *restrict src, int *restrict dst, int n, int m, int x, int y)
+  Type *PtrTy = PointerType::getUnqual(Ctx);
+  Type *Int32 = Type::getInt32Ty(Ctx);
+  FunctionType *FTy = FunctionType::get(Type::getVoidTy(Ctx), {PtrTy, PtrTy, Int32, Int32, Int32, Int32}, false);
+  static const char *ArgNames[] = {"src", "dst", "n", "m", "x", "y"};
+
+  for (unsigned i = 0; i < Opts.NumFunctions; ++i) {
+    Function *F = Function::Create(FTy, GlobalValue::ExternalLinkage, "synthetic" + Twine(i), *M);
+    for (Argument &A : F->args()) A.setName(ArgNames[A.getArgNo()]);
+    F->addParamAttr(0, Attribute::NoAlias);
+    F->addParamAttr(1, Attribute::NoAlias);
+    FunctionGenerator(*F, Opts, Rng).run();
+  }
+  return M;
+}
@@ -0,0 +1,35 @@
+#ifndef IR_GENERATOR_H
+#define IR_GENERATOR_H
+
+#include "llvm/IR/LLVMContext.h"
+#include "llvm/IR/Module.h"
+
+#include <memory>
+
+namespace llvm {
+
+// Shape of a synthetic module. Every function runs NumLoops loop nests in
+// sequence over two noalias arrays, in the form clang -O0 and mem2reg give
+// (header, body, latch), which the passes expect.
+struct IRGenOptions {
+    unsigned NumFunctions = 1;
+    unsigned NumLoops = 10;
+    // Instructions of every loop body, outside the inner loop
+    unsigned BodySize = 10;
+    // Nesting depth of every loop nest
+    unsigned Depth = 1;
+    // Fraction of the pairs of adjacent loops with the same trip count: the
+    // others run to a different bound, and cannot be fused
+    double FusableDensity = 0.5;
+    // Fraction of the body instructions with loop-invariant operands only
+    double InvariantDensity = 0.2;
+    unsigned Seed = 1;
+
+    // The values of the -gen-* options
+    static IRGenOptions fromCommandLine();
+};
+
+std::unique_ptr<Module> generateModule(LLVMContext &Ctx, const IRGenOptions &Opts);
+}
+
+#endif
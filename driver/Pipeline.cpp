@@ -0,0 +1,70 @@
+#include "Pipeline.h"
+#include "Plugin.h"
+using namespace llvm;
+
+namespace {
+
+// Declared in this order so that the proxies are destroyed first
+struct AnalysisManagers {
+  LoopAnalysisManager LAM;
+  FunctionAnalysisManager FAM;
+  CGSCCAnalysisManager CGAM;
+  ModuleAnalysisManager MAM;
+
+  explicit AnalysisManagers(PassBuilder &PB) {
+    PB.registerModuleAnalyses(MAM);
+    PB.registerCGSCCAnalyses(CGAM);
+    PB.registerFunctionAnalyses(FAM);
+    PB.registerLoopAnalyses(LAM);
+    PB.crossRegisterProxies(LAM, FAM, CGAM, MAM);
+  }
+};
+
+}
+
+OptPipeline::OptPipeline() : PB(nullptr, PipelineTuningOptions(), std::nullopt, &PIC) {
+  TimeProfiler.registerCallbacks(PIC);
+}
+
+Expected<std::unique_ptr<OptPipeline>> OptPipeline::create(StringRef PipelineText) {
+  std::unique_ptr<OptPipeline> P(new OptPipeline());
+  getLLVMOptimizationsPluginInfo().RegisterPassBuilderCallbacks(P->PB);
+
+  if (Error Err = P->PB.parsePassPipeline(P->MPM, PipelineText))
+    return std::move(Err);
+  return std::move(P);
+}
+
+Expected<std::unique_ptr<OptPipeline>> OptPipeline::createFunctionPipeline(StringRef PipelineText) {
+  std::unique_ptr<OptPipeline> P(new OptPipeline());
+  getLLVMOptimizationsPluginInfo().RegisterPassBuilderCallbacks(P->PB);
+
+  if (Error Err = P->PB.parsePassPipeline(P->FPM, PipelineText))
+    return std::move(Err);
+  P->IsFunctionPipeline = true;
+  return std::move(P);
+}
+
+void OptPipeline::run(Module &M) {
+  if (IsFunctionPipeline) {
+    run(M, [](const Function &) { return true; });
+    return;
+  }
+
+  AnalysisManagers AM(PB);
+  MPM.run(M, AM.MAM);
+}
+
+void OptPipeline::run(Module &M, function_ref<bool(const Function&)> ShouldRun) {
+  assert(IsFunctionPipeline && "not a function pipeline");
+  AnalysisManagers AM(PB);
+  FunctionAnalysisManager &FAM =
+      AM.MAM.getResult<FunctionAnalysisManagerModuleProxy>(M).getManager();
+
+  for (Function &F : M) {
+    if (F.isDeclaration() || !ShouldRun(F)) continue;
+
+    PreservedAnalyses PA = FPM.run(F, FAM);
+    FAM.invalidate(F, PA);
+  }
+}
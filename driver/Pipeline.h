@@ -0,0 +1,44 @@
+#ifndef OPT_PIPELINE_H
+#define OPT_PIPELINE_H
+
+#include "llvm/ADT/STLFunctionalExtras.h"
+#include "llvm/IR/Module.h"
+#include "llvm/IR/PassManager.h"
+#include "llvm/Passes/PassBuilder.h"
+#include "llvm/Passes/StandardInstrumentations.h"
+#include "llvm/Support/Error.h"
+
+#include <memory>
+
+namespace llvm {
+
+// A textual pipeline (opt -passes syntax) parsed once, with every pass of the
+// unified plugin registered, and run on many modules. The pass objects keep
+// state between runs, so a pipeline must be used by one thread at a time.
+// When the thread that creates it has a time trace profiler, every pass and
+// analysis gets an entry in the trace.
+class OptPipeline {
+    public:
+        static Expected<std::unique_ptr<OptPipeline>> create(StringRef PipelineText);
+        // Function passes only: every function can be optimized on its own
+        static Expected<std::unique_ptr<OptPipeline>> createFunctionPipeline(StringRef PipelineText);
+
+        // Runs the pipeline with fresh analysis managers
+        void run(Module &M);
+        // Function pipelines only: runs on the definitions accepted by
+        // ShouldRun, in module order, as the module-to-function adaptor does
+        void run(Module &M, function_ref<bool(const Function&)> ShouldRun);
+
+    private:
+        OptPipeline();
+
+        PassInstrumentationCallbacks PIC;
+        TimeProfilingPassesHandler TimeProfiler;
+        PassBuilder PB;
+        ModulePassManager MPM;
+        FunctionPassManager FPM;
+        bool IsFunctionPipeline = false;
+};
+}
+
+#endif
@@ -0,0 +1,662 @@
+#include "SplitOptimizer.h"
+
+#include "llvm/ADT/SetVector.h"
+#include "llvm/ADT/SmallPtrSet.h"
+#include "llvm/Bitcode/BitcodeReader.h"
+#include "llvm/Bitcode/BitcodeWriter.h"
+#include "llvm/IR/InstIterator.h"
+#include "llvm/IR/LLVMContext.h"
+#include "llvm/IR/ModuleSlotTracker.h"
+#include "llvm/IR/StructuralHash.h"
+#include "llvm/IR/Verifier.h"
+#include "llvm/Linker/Linker.h"
+#include "llvm/Support/raw_ostream.h"
+#include "llvm/Transforms/Utils/Cloning.h"
+using namespace llvm;
+
+namespace {
+
+// Size of the global lists of the original module: the globals the passes
+// add are appended after these
+struct GlobalCounts {
+  unsigned Vars, Functions, Aliases, IFuncs;
+
+  explicit GlobalCounts(const Module &M)
+      : Vars(M.global_size()), Functions(M.size()),
+        Aliases(M.alias_size()), IFuncs(M.ifunc_size()) {}
+};
+
+// What makeLinkable changes in a global of the original module
+struct SavedGlobal {
+  std::string Name;
+  bool Unnamed;
+  GlobalValue::LinkageTypes Linkage;
+  GlobalValue::VisibilityTypes Visibility;
+  GlobalValue::UnnamedAddr UnnamedAddr;
+  bool DSOLocal;
+  Comdat *C;
+};
+
+}
+
+template <typename ListT, typename CallbackT>
+static void forEachOriginal(ListT &&List, unsigned Count, CallbackT Callback) {
+  unsigned Idx = 0;
+  for (auto &GV : make_early_inc_range(List)) {
+    if (Idx == Count) break;
+    Callback(GV, Idx++);
+  }
+}
+
+static std::string getLinkName(const GlobalValue &GV, char Kind, unsigned Idx) {
+  if (GV.hasName()) return GV.getName().str();
+  return ("__split." + Twine(Kind) + "." + Twine(Idx)).str();
+}
+
+// The globals of the original module get the same unique name and an external
+// linkage on both sides of the link, so that the linker matches every
+// definition of a partition with the global it replaces
+static void makeLinkable(GlobalValue &GV, char Kind, unsigned Idx) {
+  if (!GV.hasName())
+    GV.setName(getLinkName(GV, Kind, Idx));
+  if (GV.hasLocalLinkage())
+    GV.setLinkage(GlobalValue::ExternalLinkage);
+}
+
+static constexpr unsigned NoPartition = ~0u;
+
+// The Selected functions by index in the module, cut into contiguous ranges
+// with about the same number of instructions; the others get NoPartition.
+// Keeping the module order, the declarations added by the passes (e.g.
+// intrinsics) are linked back in the order a serial run creates them.
+static SmallVector<unsigned> partitionFunctions(const Module &M, unsigned NumPartitions,
+                                                ArrayRef<bool> Selected) {
+  uint64_t Total = 0;
+  unsigned Idx = 0;
+  for (const Function &F : M) {
+    if (Selected[Idx++]) Total += F.getInstructionCount();
+  }
+
+  SmallVector<unsigned> Partition;
+  uint64_t Size = 0;
+  unsigned Current = 0;
+
+  Idx = 0;
+  for (const Function &F : M) {
+    if (!Selected[Idx++]) {
+      Partition.push_back(NoPartition);
+      continue;
+    }
+    Partition.push_back(Current);
+    Size += F.getInstructionCount();
+    if (Current + 1 < NumPartitions && Size * NumPartitions >= Total * (Current + 1))
+      ++Current;
+  }
+  return Partition;
+}
+
+// Globals used by the instructions of F, through constant expressions too
+static SetVector<GlobalValue*> getReferencedGlobals(Function &F) {
+  SetVector<GlobalValue*> Globals;
+  SmallPtrSet<Constant*, 32> Visited;
+  SmallVector<Constant*> Worklist;
+  auto push = [&](Value *V) {
+    if (auto *C = dyn_cast<Constant>(V); C && Visited.insert(C).second)
+      Worklist.push_back(C);
+  };
+
+  for (Instruction &I : instructions(F)) {
+    for (Value *Op : I.operands()) push(Op);
+  }
+  if (F.hasPersonalityFn()) push(F.getPersonalityFn());
+  if (F.hasPrefixData()) push(F.getPrefixData());
+  if (F.hasPrologueData()) push(F.getPrologueData());
+
+  while (!Worklist.empty()) {
+    Constant *C = Worklist.pop_back_val();
+    if (auto *GV = dyn_cast<GlobalValue>(C)) {
+      Globals.insert(GV);
+      continue;
+    }
+    for (Value *Op : C->operands()) push(Op);
+  }
+  return Globals;
+}
+
+// The unit of the cache: a module with F as its only definition, and
+// declarations of the globals F references. The declarations added by the
+// passes keep their attributes, and the new variables (e.g. the strings of
+// the library call simplifier) their initializer.
+static Error extractFunction(Function &F, GlobalCounts Counts, SmallVectorImpl<char> &Output) {
+  Module &M = *F.getParent();
+  Module Unit(M.getModuleIdentifier(), M.getContext());
+  Unit.setDataLayout(M.getDataLayout());
+  Unit.setTargetTriple(M.getTargetTriple());
+
+  SetVector<GlobalValue*> Refs = getReferencedGlobals(F);
+  ValueToValueMapTy VMap;
+  auto notCacheable = [&F](const GlobalValue &GV) {
+    return createStringError(inconvertibleErrorCode(), "cannot move " + F.getName() +
+                             " to a module of its own: it uses the new global " + GV.getName());
+  };
+
+  // In the order of the module, which for the new declarations is the order
+  // the passes created them
+  Function *NewF = nullptr;
+  unsigned Idx = 0;
+  for (Function &G : M) {
+    bool IsNew = Idx++ >= Counts.Functions;
+    if (&G != &F && !Refs.count(&G)) continue;
+    if (IsNew && !G.isDeclaration()) return notCacheable(G);
+
+    Function *Decl = Function::Create(G.getFunctionType(), GlobalValue::ExternalLinkage,
+                                      G.getAddressSpace(), G.getName(), &Unit);
+    if (IsNew) Decl->copyAttributesFrom(&G);
+    VMap[&G] = Decl;
+    if (&G == &F) NewF = Decl;
+  }
+
+  Idx = 0;
+  for (GlobalVariable &GV : M.globals()) {
+    bool IsNew = Idx++ >= Counts.Vars;
+    if (!Refs.count(&GV)) continue;
+
+    auto *Decl = new GlobalVariable(Unit, GV.getValueType(), GV.isConstant(), GlobalValue::ExternalLinkage,
+                                    nullptr, GV.getName(), nullptr, GV.getThreadLocalMode(), GV.getAddressSpace());
+    if (IsNew) {
+      if (!GV.hasInitializer() || !isa<ConstantData>(GV.getInitializer())) return notCacheable(GV);
+      Decl->copyAttributesFrom(&GV);
+      Decl->setLinkage(GV.getLinkage());
+      Decl->setInitializer(GV.getInitializer());
+    }
+    VMap[&GV] = Decl;
+  }
+
+  for (GlobalValue *GV : Refs) {
+    if (!isa<GlobalAlias>(GV) && !isa<GlobalIFunc>(GV)) continue;
+    GlobalValue *Decl;
+    if (auto *FTy = dyn_cast<FunctionType>(GV->getValueType()))
+      Decl = Function::Create(FTy, GlobalValue::ExternalLinkage, GV->getAddressSpace(), GV->getName(), &Unit);
+    else
+      Decl = new GlobalVariable(Unit, GV->getValueType(), false, GlobalValue::ExternalLinkage, nullptr,
+                                GV->getName(), nullptr, GV->getThreadLocalMode(), GV->getAddressSpace());
+    VMap[GV] = Decl;
+  }
+
+  auto NewArg = NewF->arg_begin();
+  for (Argument &A : F.args()) {
+    NewArg->setName(A.getName());
+    VMap[&A] = &*NewArg++;
+  }
+  SmallVector<ReturnInst*, 8> Returns;
+  CloneFunctionInto(NewF, &F, VMap, CloneFunctionChangeType::DifferentModule, Returns);
+  NewF->setLinkage(GlobalValue::ExternalLinkage);
+
+  // Metadata pointing to a global of the module would still reference it
+  std::string VerifyErrors;
+  raw_string_ostream VerifyOS(VerifyErrors);
+  if (verifyModule(Unit, &VerifyOS))
+    return createStringError(inconvertibleErrorCode(), "broken cache unit for " + F.getName() + "\n" + VerifyOS.str());
+
+  raw_svector_ostream OS(Output);
+  WriteBitcodeToFile(Unit, OS, /*ShouldPreserveUseListOrder=*/true);
+  return Error::success();
+}
+
+// Runs on a worker: optimizes the definitions of partition Part. Writes them
+// to Output, where everything else becomes a declaration of the global of
+// the original module; or, if Units is not empty, writes every Cacheable
+// function to Units at its index in the module (see extractFunction). The
+// others, and those that cannot be moved to a unit, are written to Output.
+static Error optimizePartition(MemoryBufferRef Input, StringRef PipelineText,
+                               ArrayRef<unsigned> Partition, unsigned Part, GlobalCounts Counts,
+                               SmallVectorImpl<char> &Output, ArrayRef<bool> Cacheable,
+                               MutableArrayRef<SmallVector<char, 0>> Units) {
+  LLVMContext Ctx;
+  Expected<std::unique_ptr<Module>> Parsed = parseBitcodeFile(Input, Ctx);
+  if (!Parsed) return Parsed.takeError();
+  Module &M = **Parsed;
+
+  SmallPtrSet<const Function*, 32> Owned;
+  unsigned Idx = 0;
+  for (Function &F : M) {
+    if (Partition[Idx++] == Part) Owned.insert(&F);
+  }
+
+  Expected<std::unique_ptr<OptPipeline>> Pipeline = OptPipeline::createFunctionPipeline(PipelineText);
+  if (!Pipeline) return Pipeline.takeError();
+  (*Pipeline)->run(M, [&](const Function &F) { return Owned.contains(&F); });
+
+  if (!Units.empty()) {
+    forEachOriginal(M.globals(), Counts.Vars, [](GlobalVariable &GV, unsigned Idx) { makeLinkable(GV, 'v', Idx); });
+    forEachOriginal(M.functions(), Counts.Functions, [](Function &F, unsigned Idx) { makeLinkable(F, 'f', Idx); });
+    forEachOriginal(M.aliases(), Counts.Aliases, [](GlobalAlias &GA, unsigned Idx) { makeLinkable(GA, 'a', Idx); });
+    forEachOriginal(M.ifuncs(), Counts.IFuncs, [](GlobalIFunc &GI, unsigned Idx) { makeLinkable(GI, 'i', Idx); });
+
+    SmallPtrSet<const Function*, 32> NotExtracted;
+    Idx = 0;
+    for (Function &F : M) {
+      if (Idx >= Counts.Functions) break;
+      if (Owned.contains(&F)) {
+        Error Err = Cacheable[Idx] ? extractFunction(F, Counts, Units[Idx]) : Error::success();
+        if (!Cacheable[Idx] || Err) {
+          consumeError(std::move(Err));
+          Units[Idx].clear();
+          NotExtracted.insert(&F);
+        }
+      }
+      ++Idx;
+    }
+    if (NotExtracted.empty()) return Error::success();
+    Owned = std::move(NotExtracted);
+  }
+
+  forEachOriginal(M.globals(), Counts.Vars, [](GlobalVariable &GV, unsigned Idx) {
+    // llvm.used, llvm.global_ctors, ... stay in the original module
+    if (GV.hasAppendingLinkage()) {
+      GV.eraseFromParent();
+      return;
+    }
+    makeLinkable(GV, 'v', Idx);
+    GV.setInitializer(nullptr);
+    GV.setLinkage(GlobalValue::ExternalLinkage);
+    GV.setComdat(nullptr);
+  });
+
+  forEachOriginal(M.functions(), Counts.Functions, [&](Function &F, unsigned Idx) {
+    makeLinkable(F, 'f', Idx);
+    F.setComdat(nullptr);
+    if (!Owned.contains(&F)) F.deleteBody();
+  });
+
+  // Aliases and ifuncs are definitions too: replaced by plain declarations
+  auto replaceWithDeclaration = [&M](GlobalValue &GV, char Kind, unsigned Idx) {
+    makeLinkable(GV, Kind, Idx);
+    GlobalValue *Decl;
+    if (auto *FTy = dyn_cast<FunctionType>(GV.getValueType()))
+      Decl = Function::Create(FTy, GlobalValue::ExternalLinkage, GV.getAddressSpace(), "", &M);
+    else
+      Decl = new GlobalVariable(M, GV.getValueType(), false, GlobalValue::ExternalLinkage,
+                                nullptr, "", nullptr, GV.getThreadLocalMode(), GV.getAddressSpace());
+    Decl->takeName(&GV);
+    GV.replaceAllUsesWith(Decl);
+    GV.eraseFromParent();
+  };
+  forEachOriginal(M.aliases(), Counts.Aliases, [&](GlobalAlias &GA, unsigned Idx) {
+    replaceWithDeclaration(GA, 'a', Idx);
+  });
+  forEachOriginal(M.ifuncs(), Counts.IFuncs, [&](GlobalIFunc &GI, unsigned Idx) {
+    replaceWithDeclaration(GI, 'i', Idx);
+  });
+
+  // Module flags, llvm.ident, ... would be appended twice
+  for (NamedMDNode &NMD : make_early_inc_range(M.named_metadata()))
+    M.eraseNamedMetadata(&NMD);
+
+  raw_svector_ostream OS(Output);
+  WriteBitcodeToFile(M, OS, /*ShouldPreserveUseListOrder=*/true);
+  return Error::success();
+}
+
+// The linker appends the globals it replaces to their list: the globals of
+// the original module go back to their position, followed by the new ones
+template <typename GlobalT, typename ListT>
+static SmallVector<GlobalT*> getOriginalOrder(Module &M, ListT &&List, ArrayRef<std::string> Names) {
+  SmallVector<GlobalT*> Order;
+  SmallPtrSet<GlobalT*, 32> Originals;
+
+  for (const std::string &Name : Names) {
+    auto *GV = cast<GlobalT>(M.getNamedValue(Name));
+    Order.push_back(GV);
+    Originals.insert(GV);
+  }
+  for (GlobalT &GV : List) {
+    if (!Originals.contains(&GV)) Order.push_back(&GV);
+  }
+  return Order;
+}
+
+// Replaces the definitions of M with the optimized ones, then gives every
+// global back its name, linkage and position
+static Error linkPartitions(Module &M, ArrayRef<StringRef> Partitions, GlobalCounts Counts) {
+  std::vector<SavedGlobal> Saved;
+  SmallVector<std::string> VarOrder, FunctionOrder;
+
+  auto save = [&](GlobalValue &GV, char Kind, unsigned Idx) {
+    Comdat *C = isa<GlobalObject>(GV) ? cast<GlobalObject>(GV).getComdat() : nullptr;
+    Saved.push_back({"", !GV.hasName(), GV.getLinkage(), GV.getVisibility(),
+                     GV.getUnnamedAddr(), GV.isDSOLocal(), C});
+    makeLinkable(GV, Kind, Idx);
+    Saved.back().Name = GV.getName().str();
+  };
+  forEachOriginal(M.globals(), Counts.Vars, [&](GlobalVariable &GV, unsigned Idx) {
+    save(GV, 'v', Idx);
+    VarOrder.push_back(GV.getName().str());
+  });
+  forEachOriginal(M.functions(), Counts.Functions, [&](Function &F, unsigned Idx) {
+    save(F, 'f', Idx);
+    FunctionOrder.push_back(F.getName().str());
+  });
+  forEachOriginal(M.aliases(), Counts.Aliases, [&](GlobalAlias &GA, unsigned Idx) { save(GA, 'a', Idx); });
+  forEachOriginal(M.ifuncs(), Counts.IFuncs, [&](GlobalIFunc &GI, unsigned Idx) { save(GI, 'i', Idx); });
+
+  for (StringRef Bitcode : Partitions) {
+    MemoryBufferRef Buffer(Bitcode, M.getModuleIdentifier());
+    Expected<std::unique_ptr<Module>> Part = parseBitcodeFile(Buffer, M.getContext());
+    if (!Part) return Part.takeError();
+
+    // The linker only brings in the declarations in use: the new ones are
+    // created first, in the order of the partition
+    for (Function &F : **Part) {
+      if (!F.isDeclaration() || M.getNamedValue(F.getName())) continue;
+      Function *Decl = Function::Create(F.getFunctionType(), F.getLinkage(), F.getAddressSpace(), F.getName(), &M);
+      Decl->copyAttributesFrom(&F);
+    }
+
+    if (Linker::linkModules(M, std::move(*Part), Linker::Flags::OverrideFromSrc))
+      return createStringError(inconvertibleErrorCode(), "cannot link an optimized partition back");
+  }
+
+  for (GlobalVariable *GV : getOriginalOrder<GlobalVariable>(M, M.globals(), VarOrder)) {
+    M.removeGlobalVariable(GV);
+    M.insertGlobalVariable(GV);
+  }
+  for (Function *F : getOriginalOrder<Function>(M, M.functions(), FunctionOrder))
+    M.getFunctionList().splice(M.end(), M.getFunctionList(), F->getIterator());
+
+  for (const SavedGlobal &S : Saved) {
+    GlobalValue *GV = M.getNamedValue(S.Name);
+    GV->setLinkage(S.Linkage);
+    GV->setVisibility(S.Visibility);
+    GV->setUnnamedAddr(S.UnnamedAddr);
+    GV->setDSOLocal(S.DSOLocal);
+    if (auto *GO = dyn_cast<GlobalObject>(GV)) GO->setComdat(S.C);
+    if (S.Unnamed) GV->setName("");
+  }
+
+  return Error::success();
+}
+
+namespace {
+
+// What a function pass may read when it optimizes a function: the cache key.
+// The instructions are printed with their names and the numbers of the
+// unnamed values, which are local to the function. The metadata and attribute
+// groups, numbered across the module, are written out in full, and so are the
+// globals the function references.
+class FingerprintWriter {
+  public:
+    FingerprintWriter(Module &M, function_ref<StringRef(const GlobalValue&)> LinkName)
+        : MST(&M), LinkName(LinkName) {
+      M.getContext().getMDKindNames(KindNames);
+    }
+
+    // False if F cannot be cached: its body could not be moved to a module of
+    // its own (metadata pointing to globals), or carries debug info
+    bool write(Function &F, raw_ostream &OS);
+
+  private:
+    bool writeMetadata(const Metadata *MD, raw_ostream &OS);
+    bool writeAttachments(const Value &V, raw_ostream &OS);
+    void writeAttributes(AttributeList Attrs, raw_ostream &OS);
+
+    ModuleSlotTracker MST;
+    function_ref<StringRef(const GlobalValue&)> LinkName;
+    SmallVector<StringRef> KindNames;
+    // Metadata already written, by order of appearance in the function
+    DenseMap<const Metadata*, unsigned> Seen;
+};
+
+}
+
+bool FingerprintWriter::writeMetadata(const Metadata *MD, raw_ostream &OS) {
+  if (!MD) {
+    OS << "null";
+    return true;
+  }
+  auto [It, Inserted] = Seen.try_emplace(MD, Seen.size());
+  if (!Inserted) {
+    OS << "^" << It->second;
+    return true;
+  }
+
+  if (auto *S = dyn_cast<MDString>(MD)) {
+    OS << S->getLength() << '"' << S->getString();
+    return true;
+  }
+  if (auto *V = dyn_cast<ConstantAsMetadata>(MD)) {
+    if (!isa<ConstantData>(V->getValue())) return false;
+    V->getValue()->printAsOperand(OS, /*PrintType=*/true, MST);
+    return true;
+  }
+
+  // The specialized nodes (debug info) keep fields out of their operands
+  auto *N = dyn_cast<MDTuple>(MD);
+  if (!N) return false;
+  OS << (N->isDistinct() ? "distinct !{" : "!{");
+  for (const MDOperand &Op : N->operands()) {
+    if (!writeMetadata(Op.get(), OS)) return false;
+    OS << ",";
+  }
+  OS << "}";
+  return true;
+}
+
+bool FingerprintWriter::writeAttachments(const Value &V, raw_ostream &OS) {
+  SmallVector<std::pair<unsigned, MDNode*>> MDs;
+  if (auto *I = dyn_cast<Instruction>(&V)) I->getAllMetadata(MDs);
+  else cast<GlobalObject>(V).getAllMetadata(MDs);
+
+  for (const auto &[Kind, MD] : MDs) {
+    OS << " !" << KindNames[Kind] << " ";
+    if (!writeMetadata(MD, OS)) return false;
+  }
+  return true;
+}
+
+void FingerprintWriter::writeAttributes(AttributeList Attrs, raw_ostream &OS) {
+  for (unsigned Idx : Attrs.indexes())
+    OS << " [" << Attrs.getAsString(Idx) << "]";
+}
+
+bool FingerprintWriter::write(Function &F, raw_ostream &OS) {
+  Seen.clear();
+  OS << StructuralHash(F, /*DetailedHash=*/true) << "\n";
+
+  OS << LinkName(F) << " " << F.getLinkage() << " " << F.getCallingConv() << " ";
+  F.getFunctionType()->print(OS);
+  writeAttributes(F.getAttributes(), OS);
+  if (F.hasSection()) OS << " section " << F.getSection();
+  if (F.hasGC()) OS << " gc " << F.getGC();
+  if (!writeAttachments(F, OS)) return false;
+  OS << "\n";
+
+  for (const Argument &A : F.args())
+    OS << A.getName() << ",";
+  OS << "\n";
+
+  for (const BasicBlock &BB : F) {
+    OS << BB.getName() << ":\n";
+    for (const Instruction &I : BB) {
+      I.print(OS, MST);
+      if (auto *CB = dyn_cast<CallBase>(&I)) writeAttributes(CB->getAttributes(), OS);
+      if (!writeAttachments(I, OS)) return false;
+      // Metadata arguments of intrinsics
+      for (const Value *Op : I.operands()) {
+        if (auto *MV = dyn_cast<MetadataAsValue>(Op)) {
+          OS << " ";
+          if (!writeMetadata(MV->getMetadata(), OS)) return false;
+        }
+      }
+      OS << "\n";
+    }
+  }
+
+  for (GlobalValue *GV : getReferencedGlobals(F)) {
+    OS << "@" << LinkName(*GV) << " " << GV->getLinkage() << " ";
+    GV->getValueType()->print(OS);
+    if (auto *G = dyn_cast<Function>(GV)) {
+      OS << " " << G->getCallingConv();
+      writeAttributes(G->getAttributes(), OS);
+    } else if (auto *G = dyn_cast<GlobalVariable>(GV)) {
+      // The passes fold the loads of constants
+      OS << (G->isConstant() ? " constant " : " global ");
+      if (G->isConstant() && G->hasDefinitiveInitializer())
+        G->getInitializer()->printAsOperand(OS, /*PrintType=*/true, MST);
+    }
+    OS << "\n";
+  }
+  return true;
+}
+
+bool SplitOptimizer::canSplit(const Module &M) {
+  if (M.getNamedMetadata("llvm.dbg.cu")) return false;
+
+  for (const Function &F : M) {
+    for (const BasicBlock &BB : F) {
+      if (BB.hasAddressTaken()) return false;
+    }
+  }
+  return true;
+}
+
+void SplitOptimizer::rebuildSymbolTables(Module &M) {
+  for (Function &F : make_early_inc_range(M)) {
+    if (F.isDeclaration()) continue;
+
+    Function *NewF = Function::Create(F.getFunctionType(), F.getLinkage(), F.getAddressSpace());
+    M.getFunctionList().insert(F.getIterator(), NewF);
+    NewF->copyAttributesFrom(&F);
+    NewF->setComdat(F.getComdat());
+    NewF->copyMetadata(&F, 0);
+
+    NewF->stealArgumentListFrom(F);
+    NewF->splice(NewF->end(), &F);
+    F.replaceAllUsesWith(NewF);
+    NewF->takeName(&F);
+    F.eraseFromParent();
+  }
+}
+
+Error SplitOptimizer::runSerially(Module &M) {
+  Expected<std::unique_ptr<OptPipeline>> Pipeline = OptPipeline::createFunctionPipeline(PipelineText);
+  if (!Pipeline) return Pipeline.takeError();
+  (*Pipeline)->run(M);
+  rebuildSymbolTables(M);
+  return Error::success();
+}
+
+void SplitOptimizer::lookupFunctions(Module &M, SmallVectorImpl<std::optional<FunctionCache::Key>> &Keys,
+                                     SmallVectorImpl<std::optional<StringRef>> &Cached) {
+  // The names the link gives to the unnamed globals are part of the key
+  DenseMap<const GlobalValue*, std::string> LinkNames;
+  auto addName = [&](char Kind) {
+    return [&LinkNames, Kind](GlobalValue &GV, unsigned Idx) {
+      if (!GV.hasName()) LinkNames[&GV] = getLinkName(GV, Kind, Idx);
+    };
+  };
+  forEachOriginal(M.globals(), M.global_size(), addName('v'));
+  forEachOriginal(M.functions(), M.size(), addName('f'));
+  forEachOriginal(M.aliases(), M.alias_size(), addName('a'));
+  forEachOriginal(M.ifuncs(), M.ifunc_size(), addName('i'));
+
+  FingerprintWriter Writer(M, [&](const GlobalValue &GV) {
+    return GV.hasName() ? GV.getName() : StringRef(LinkNames[&GV]);
+  });
+  for (Function &F : M) {
+    if (F.isDeclaration()) {
+      Keys.emplace_back();
+      continue;
+    }
+    // The same function built for another target is optimized differently
+    std::string Fingerprint;
+    raw_string_ostream OS(Fingerprint);
+    OS << "datalayout=" << M.getDataLayoutStr() << " triple=" << M.getTargetTriple() << "\n";
+    if (Writer.write(F, OS)) Keys.push_back(Cache->getKey(OS.str()));
+    else Keys.emplace_back();
+  }
+
+  Cached.resize(Keys.size());
+  for (unsigned Idx = 0; Idx < Keys.size(); ++Idx) {
+    if (Keys[Idx]) Cached[Idx] = Cache->lookup(*Keys[Idx]);
+  }
+}
+
+Error SplitOptimizer::run(Module &M) {
+  if (!canSplit(M)) return runSerially(M);
+
+  // The functions to optimize: with a cache, the ones it misses
+  SmallVector<std::optional<FunctionCache::Key>, 0> Keys;
+  SmallVector<std::optional<StringRef>, 0> Cached;
+  bool UseCache = Cache != nullptr;
+  if (UseCache) lookupFunctions(M, Keys, Cached);
+
+  SmallVector<bool> Selected;
+  for (Function &F : M)
+    Selected.push_back(!F.isDeclaration() && !(UseCache && Cached[Selected.size()]));
+
+  SmallVector<unsigned> Partition = partitionFunctions(M, NumPartitions, Selected);
+  unsigned NumUsed = 0;
+  for (unsigned Part : Partition) {
+    if (Part != NoPartition) NumUsed = std::max(NumUsed, Part + 1);
+  }
+  if (!UseCache && NumUsed < 2) return runSerially(M);
+
+  // The workers read the module with the use lists in the same order, so that
+  // the passes see the same IR as in a serial run
+  SmallVector<char, 0> Bitcode;
+  raw_svector_ostream OS(Bitcode);
+  WriteBitcodeToFile(M, OS, /*ShouldPreserveUseListOrder=*/true);
+  MemoryBufferRef Input(StringRef(Bitcode.data(), Bitcode.size()), M.getModuleIdentifier());
+  GlobalCounts Counts(M);
+
+  std::vector<SmallVector<char, 0>> Results(NumUsed);
+  std::vector<SmallVector<char, 0>> Units(UseCache ? M.size() : 0);
+  SmallVector<bool> Cacheable;
+  for (const std::optional<FunctionCache::Key> &Key : Keys)
+    Cacheable.push_back(Key.has_value());
+  std::vector<std::string> Errors(NumUsed);
+
+  for (unsigned Part = 0; Part < NumUsed; ++Part) {
+    Pool.async([&, Part] {
+      if (Error Err = optimizePartition(Input, PipelineText, Partition, Part, Counts, Results[Part], Cacheable, Units))
+        Errors[Part] = toString(std::move(Err));
+    });
+  }
+  Pool.wait();
+
+  for (unsigned Part = 0; Part < NumUsed; ++Part) {
+    if (!Errors[Part].empty())
+      return createStringError(inconvertibleErrorCode(), "partition " + Twine(Part) + ": " + Errors[Part]);
+  }
+
+  if (!UseCache) {
+    SmallVector<StringRef> Partitions;
+    for (const SmallVector<char, 0> &Result : Results)
+      Partitions.push_back(StringRef(Result.data(), Result.size()));
+    return linkPartitions(M, Partitions, Counts);
+  }
+
+  // One unit per function, in the order of the module. The functions not
+  // moved to a unit come with the output of their partition, linked once
+  SmallVector<StringRef, 0> Linked;
+  SmallVector<bool> PartitionLinked(NumUsed);
+  for (unsigned Idx = 0; Idx < Selected.size(); ++Idx) {
+    if (Cached[Idx]) {
+      Linked.push_back(*Cached[Idx]);
+    } else if (Selected[Idx] && !Units[Idx].empty()) {
+      Linked.push_back(StringRef(Units[Idx].data(), Units[Idx].size()));
+    } else if (Selected[Idx] && !PartitionLinked[Partition[Idx]]) {
+      const SmallVector<char, 0> &Result = Results[Partition[Idx]];
+      Linked.push_back(StringRef(Result.data(), Result.size()));
+      PartitionLinked[Partition[Idx]] = true;
+    }
+  }
+  if (Error Err = linkPartitions(M, Linked, Counts)) return Err;
+
+  for (unsigned Idx = 0; Idx < Selected.size(); ++Idx) {
+    if (Selected[Idx] && !Units[Idx].empty())
+      Cache->insert(*Keys[Idx], StringRef(Units[Idx].data(), Units[Idx].size()));
+  }
+  return Error::success();
+}
@@ -0,0 +1,60 @@
+#ifndef SPLIT_OPTIMIZER_H
+#define SPLIT_OPTIMIZER_H
+
+#include "FunctionCache.h"
+#include "Pipeline.h"
+
+#include "llvm/IR/Module.h"
+#include "llvm/Support/Error.h"
+#include "llvm/Support/ThreadPool.h"
+
+#include <string>
+
+namespace llvm {
+
+// Optimizes the function definitions of one module in parallel. The module is
+// cut into partitions of contiguous functions, each partition is optimized by
+// a worker thread in its own LLVMContext, and the optimized definitions are
+// linked back in place. The result is bit-identical to running the function
+// pipeline serially on the whole module, then rebuildSymbolTables.
+//
+// With a cache, the functions found in it are not optimized: their cached
+// bodies are linked in instead. The others are linked back one function at a
+// time, and stored in the cache; those that cannot be cached are optimized
+// and linked back as without a cache.
+class SplitOptimizer {
+    public:
+        // PipelineText must be a function pipeline (see OptPipeline)
+        SplitOptimizer(StringRef PipelineText, DefaultThreadPool &Pool, unsigned NumPartitions,
+                       FunctionCache *Cache = nullptr)
+            : PipelineText(PipelineText), Pool(Pool), NumPartitions(NumPartitions), Cache(Cache) {}
+
+        Error run(Module &M);
+
+        // Modules that cannot be split are optimized serially: debug info
+        // would be duplicated by the link, and block addresses tie the bodies
+        // of two functions together
+        static bool canSplit(const Module &M);
+
+        // The bitcode writer emits the local names of a function in the order
+        // of its symbol table, which depends on the history of the function.
+        // Moves every body to a new function, whose table is filled in
+        // instruction order as the link back does: used after every run that
+        // is not split, which then gives the same bitcode as the split ones.
+        static void rebuildSymbolTables(Module &M);
+
+    private:
+        Error runSerially(Module &M);
+        // Fills Keys and Cached for every function of M, in module order. A
+        // declaration or a function that cannot be cached has no key
+        void lookupFunctions(Module &M, SmallVectorImpl<std::optional<FunctionCache::Key>> &Keys,
+                             SmallVectorImpl<std::optional<StringRef>> &Cached);
+
+        std::string PipelineText;
+        DefaultThreadPool &Pool;
+        unsigned NumPartitions;
+        FunctionCache *Cache;
+};
+}
+
+#endif
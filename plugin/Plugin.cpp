@@ -0,0 +1,104 @@
+#include "Plugin.h"
+#include "LocalOpts.h"
+#include "SCCP.h"
+#include "DFA.h"
+#include "VBEHoist.h"
+#include "LICMopt.h"
+#include "LoopUnswitch.h"
+#include "LoopFusion.h"
+#include "LoopDeletion.h"
+#include "IVStrengthReduction.h"
+#include "LoopProfile.h"
+
+#include "llvm/Support/CommandLine.h"
+#include "llvm/Transforms/Utils/LCSSA.h"
+#include "llvm/Transforms/Utils/LoopSimplify.h"
+using namespace llvm;
+
+// Every pass can be switched off from the command line, e.g.
+//   clang -O2 -fpass-plugin=libLLVMOptimizations.so -mllvm -enable-licm-opt=false
+static cl::opt<bool> EnableSCCP("enable-sccp-opt", cl::init(true),
+    cl::desc("Run SCCP-opt at the peephole extension point"));
+static cl::opt<bool> EnableLocalOpts("enable-local-opts", cl::init(true),
+    cl::desc("Run local-opts at the peephole extension point"));
+static cl::opt<bool> EnableVBEHoist("enable-vbe-hoist", cl::init(true),
+    cl::desc("Run VBE-hoist after the scalar optimizations"));
+static cl::opt<bool> EnableLICM("enable-licm-opt", cl::init(true),
+    cl::desc("Run LICM-opt in the loop pipeline, next to LICM"));
+static cl::opt<bool> EnableIVSR("enable-ivsr-opt", cl::init(true),
+    cl::desc("Run IVSR-opt at the end of the loop pipeline"));
+static cl::opt<bool> EnableLoopFusion("enable-loop-fusion-opt", cl::init(false),
+    cl::desc("Run LoopFusion-opt before the vectorizer (experimental)"));
+static cl::opt<bool> EnableLoopUnswitch("enable-loop-unswitch-opt", cl::init(true),
+    cl::desc("Run LoopUnswitch-opt before the vectorizer"));
+static cl::opt<bool> EnableLoopDeletion("enable-loop-deletion-opt", cl::init(true),
+    cl::desc("Run LoopDeletion-opt before the vectorizer, after the other loop passes"));
+
+static void registerPipelineExtensions(PassBuilder &PB) {
+  // After InstCombine
+  PB.registerPeepholeEPCallback(
+    [](FunctionPassManager &FPM, OptimizationLevel Level) {
+      if (Level == OptimizationLevel::O0) return;
+      if (EnableSCCP) FPM.addPass(SCCPOpt());
+      if (EnableLocalOpts) FPM.addPass(LocalOpts());
+    });
+
+  // Loop pipeline, right after the rotation and LICM of the loops
+  PB.registerLateLoopOptimizationsEPCallback(
+    [](LoopPassManager &LPM, OptimizationLevel Level) {
+      if (EnableLICM) LPM.addPass(LICMoptLoopPass());
+    });
+
+  // Loop pipeline, after indvars and the full unrolling
+  PB.registerLoopOptimizerEndEPCallback(
+    [](LoopPassManager &LPM, OptimizationLevel Level) {
+      if (EnableIVSR) LPM.addPass(IVStrengthReductionLoopPass());
+    });
+
+  // Once GVN and the other scalar passes have cleaned up the function
+  PB.registerScalarOptimizerLateEPCallback(
+    [](FunctionPassManager &FPM, OptimizationLevel Level) {
+      if (EnableVBEHoist) FPM.addPass(VBEHoistOpt());
+    });
+
+  // Whole-function loop transformations, which rebuild the LoopInfo
+  // themselves and need the loops in simplified and LCSSA form
+  PB.registerVectorizerStartEPCallback(
+    [](FunctionPassManager &FPM, OptimizationLevel Level) {
+      if (!EnableLoopFusion && !EnableLoopUnswitch && !EnableLoopDeletion) return;
+      FPM.addPass(LoopSimplifyPass());
+      FPM.addPass(LCSSAPass());
+      if (EnableLoopFusion) FPM.addPass(LoopFusionOpt());
+      if (EnableLoopUnswitch) FPM.addPass(LoopUnswitchOpt());
+      // The loops left empty by the passes above
+      if (EnableLoopDeletion) {
+        FPM.addPass(LoopSimplifyPass());
+        FPM.addPass(LCSSAPass());
+        FPM.addPass(LoopDeletionOpt());
+      }
+    });
+}
+
+// All the passes of the assignments: the pipeline names of every plugin plus
+// the extension points of the default -O1/-O2/-O3 pipelines
+PassPluginLibraryInfo getLLVMOptimizationsPluginInfo() {
+  return {
+    LLVM_PLUGIN_API_VERSION,
+    "LLVMOptimizations",
+    "v1.0",
+    [](PassBuilder &PB) {
+      getLocalOptsPluginInfo().RegisterPassBuilderCallbacks(PB);
+      getDFAPluginInfo().RegisterPassBuilderCallbacks(PB);
+      getLICMoptPluginInfo().RegisterPassBuilderCallbacks(PB);
+      getLoopFusionPluginInfo().RegisterPassBuilderCallbacks(PB);
+      getIVStrengthReductionPluginInfo().RegisterPassBuilderCallbacks(PB);
+      getLoopProfilePluginInfo().RegisterPassBuilderCallbacks(PB);
+      registerPipelineExtensions(PB);
+    }
+  };
+}
+
+extern "C" LLVM_ATTRIBUTE_WEAK ::llvm::PassPluginLibraryInfo
+llvmGetPassPluginInfo() {
+  return getLLVMOptimizationsPluginInfo();
+}
@@ -0,0 +1,11 @@
+#ifndef LLVM_OPTIMIZATIONS_PLUGIN_H
+#define LLVM_OPTIMIZATIONS_PLUGIN_H
+
+#include "llvm/Passes/PassBuilder.h"
+#include "llvm/Passes/PassPlugin.h"
+
+// Every pass of the assignments, registered by name and at the extension
+// points of the default pipelines
+llvm::PassPluginLibraryInfo getLLVMOptimizationsPluginInfo();
+
+#endif
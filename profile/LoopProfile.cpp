@@ -0,0 +1,337 @@
+#include "LoopProfile.h"
+
+#include "llvm/ADT/Statistic.h"
+#include "llvm/ADT/StringSet.h"
+#include "llvm/IR/MDBuilder.h"
+#include "llvm/Support/CommandLine.h"
+#include "llvm/Support/LineIterator.h"
+#include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Transforms/Utils/BasicBlockUtils.h"
+#include "llvm/Transforms/Utils/ModuleUtils.h"
+
+#include <algorithm>
+#include <array>
+using namespace llvm;
+
+#define DEBUG_TYPE "loop-profile-instr"
+
+STATISTIC(NumInstrumentedLoops, "Loops instrumented");
+STATISTIC(NumNotInstrumented, "Functions not instrumented: loops not in simplified form");
+
+static cl::opt<std::string> LoopProfileUse("loop-profile-use",
+    cl::desc("Only transform the hot loops of this loop profile "
+             "(written by the programs instrumented by loop-profile-instr)"));
+static cl::opt<unsigned> HotCoverage("loop-profile-hot-coverage", cl::init(99),
+    cl::desc("Percentage of the profiled cycles spent in the hot loops"));
+
+// Counters of a loop, in the thread counters and in the profile
+enum LoopCounter { Entries, Iterations, Cycles, NumLoopCounters };
+
+namespace {
+
+// Profile written by LoopProfileRT: for every function, a line with its name
+// and number of loops, then one line per loop (in preorder) with the number of
+// times it was entered, its iterations and its cycles:
+//   # loop profile
+//   main 2
+//   1 1000 52310
+//   1000 32000 1409825
+class LoopProfile {
+public:
+  Error read(StringRef Path);
+  // Null if the function is not in the profile
+  const std::vector<std::array<uint64_t, NumLoopCounters>> *lookup(StringRef Function) const;
+  bool isHot(const std::array<uint64_t, NumLoopCounters> &Loop) const;
+
+private:
+  StringMap<std::vector<std::array<uint64_t, NumLoopCounters>>> functions;
+  // Without a cycle counter on the target, the hot loops are those with the
+  // most iterations
+  LoopCounter weight = Cycles;
+  uint64_t hotWeight = 0;
+};
+
+} // namespace
+
+Error LoopProfile::read(StringRef Path) {
+  ErrorOr<std::unique_ptr<MemoryBuffer>> Buffer = MemoryBuffer::getFile(Path);
+  if (!Buffer)
+    return createStringError(Buffer.getError(), "cannot read " + Path + ": " + Buffer.getError().message());
+
+  auto malformed = [&](int64_t lineNumber) {
+    return createStringError(inconvertibleErrorCode(), Path + ":" + Twine(lineNumber) + ": malformed loop profile");
+  };
+
+  // Functions with internal linkage may share a name: the loops of the
+  // functions with the same name and number of loops are added up, the others
+  // are dropped
+  StringSet<> ambiguous;
+  line_iterator line(**Buffer, /*SkipBlanks=*/true, '#');
+  while (!line.is_at_eof()) {
+    std::pair<StringRef, StringRef> nameAndLoops = line->rsplit(' ');
+    unsigned numLoops;
+    if (nameAndLoops.first.empty() || nameAndLoops.second.getAsInteger(10, numLoops))
+      return malformed(line.line_number());
+    ++line;
+
+    std::vector<std::array<uint64_t, NumLoopCounters>> loops(numLoops);
+    for (std::array<uint64_t, NumLoopCounters> &counters : loops) {
+      SmallVector<StringRef, NumLoopCounters> fields;
+      if (!line.is_at_eof()) line->split(fields, ' ', -1, /*KeepEmpty=*/false);
+      if (fields.size() != NumLoopCounters) return malformed(line.line_number());
+      for (unsigned i = 0; i < NumLoopCounters; ++i)
+        if (fields[i].getAsInteger(10, counters[i])) return malformed(line.line_number());
+      ++line;
+    }
+
+    auto [it, inserted] = functions.try_emplace(nameAndLoops.first, std::move(loops));
+    if (inserted) continue;
+    if (it->second.size() != numLoops) {
+      ambiguous.insert(nameAndLoops.first);
+      continue;
+    }
+    for (unsigned i = 0; i < numLoops; ++i)
+      for (unsigned c = 0; c < NumLoopCounters; ++c)
+        it->second[i][c] += loops[i][c];
+  }
+  for (const auto &name : ambiguous)
+    functions.erase(name.getKey());
+
+  // The hot loops are the fewest, heaviest loops that cover HotCoverage% of
+  // the total weight
+  SmallVector<uint64_t, 0> weights;
+  uint64_t totalCycles = 0;
+  for (const auto &function : functions)
+    for (const auto &loop : function.getValue())
+      totalCycles += loop[Cycles];
+  if (!totalCycles) weight = Iterations;
+
+  uint64_t total = 0;
+  for (const auto &function : functions)
+    for (const auto &loop : function.getValue()) {
+      weights.push_back(loop[weight]);
+      total += loop[weight];
+    }
+  llvm::sort(weights, std::greater<uint64_t>());
+
+  uint64_t covered = 0;
+  hotWeight = UINT64_MAX;
+  for (uint64_t w : weights) {
+    if (!w || (double)covered >= (double)total * HotCoverage / 100) break;
+    covered += w;
+    hotWeight = w;
+  }
+  return Error::success();
+}
+
+const std::vector<std::array<uint64_t, NumLoopCounters>> *LoopProfile::lookup(StringRef Function) const {
+  auto it = functions.find(Function);
+  return it == functions.end() ? nullptr : &it->second;
+}
+
+bool LoopProfile::isHot(const std::array<uint64_t, NumLoopCounters> &Loop) const {
+  return Loop[weight] && Loop[weight] >= hotWeight;
+}
+
+// Read once, by the first thread that needs it
+static const LoopProfile *getLoopProfile(Function &F) {
+  if (LoopProfileUse.empty()) return nullptr;
+
+  static const std::pair<LoopProfile, std::string> loaded = [] {
+    std::pair<LoopProfile, std::string> result;
+    if (Error Err = result.first.read(LoopProfileUse))
+      result.second = toString(std::move(Err));
+    return result;
+  }();
+
+  if (!loaded.second.empty()) {
+    F.getContext().emitError("-loop-profile-use: " + loaded.second);
+    return nullptr;
+  }
+  return &loaded.first;
+}
+
+LoopHotness::LoopHotness(Function &F, LoopInfo &LI, BlockFrequencyInfo *BFI, ProfileSummaryInfo *PSI) {
+  if (const LoopProfile *profile = getLoopProfile(F)) {
+    SmallVector<Loop*, 4> loops = LI.getLoopsInPreorder();
+    // Not profiled, or changed since: nothing is known
+    const auto *counters = profile->lookup(F.getName());
+    if (!counters || counters->size() != loops.size()) return;
+
+    for (unsigned i = 0; i < loops.size(); ++i)
+      if (!profile->isHot((*counters)[i]))
+        coldHeaders.insert(loops[i]->getHeader());
+    return;
+  }
+
+  if (BFI && PSI && PSI->hasProfileSummary() && F.hasProfileData()) {
+    for (Loop *L : LI.getLoopsInPreorder())
+      if (!PSI->isHotBlock(L->getHeader(), BFI))
+        coldHeaders.insert(L->getHeader());
+  }
+}
+
+LoopHotness LoopHotness::get(Function &F, FunctionAnalysisManager &FAM) {
+  auto &LI = FAM.getResult<LoopAnalysis>(F);
+  auto &MAMProxy = FAM.getResult<ModuleAnalysisManagerFunctionProxy>(F);
+  ProfileSummaryInfo *PSI = MAMProxy.getCachedResult<ProfileSummaryAnalysis>(*F.getParent());
+
+  BlockFrequencyInfo *BFI = nullptr;
+  if (LoopProfileUse.empty() && PSI && PSI->hasProfileSummary() && F.hasProfileData())
+    BFI = &FAM.getResult<BlockFrequencyAnalysis>(F);
+  return LoopHotness(F, LI, BFI, PSI);
+}
+
+PreservedAnalyses LoopProfileInstr::run(Module &M, ModuleAnalysisManager &MAM) {
+  auto &FAM = MAM.getResult<FunctionAnalysisManagerModuleProxy>(M).getManager();
+
+  // The blocks to instrument are collected first: the loops of a function are
+  // numbered before its blocks are split
+  struct LoopBlocks {
+    BasicBlock *preheader, *header;
+    SmallVector<BasicBlock*, 4> exits;
+    bool outermost;
+  };
+  std::vector<std::pair<Function*, std::vector<LoopBlocks>>> functions;
+  unsigned numLoops = 0;
+
+  for (Function &F : M) {
+    if (F.isDeclaration()) continue;
+    auto &LI = FAM.getResult<LoopAnalysis>(F);
+    if (LI.empty()) continue;
+
+    auto &ORE = FAM.getResult<OptimizationRemarkEmitterAnalysis>(F);
+    std::vector<LoopBlocks> loops;
+    for (Loop *L : LI.getLoopsInPreorder()) {
+      LoopBlocks blocks{L->getLoopPreheader(), L->getHeader(), {}, L->isOutermost()};
+      L->getUniqueExitBlocks(blocks.exits);
+
+      bool simplified = blocks.preheader && L->hasDedicatedExits() &&
+                        none_of(blocks.exits, [](BasicBlock *BB) { return BB->getFirstInsertionPt() == BB->end(); });
+      if (!simplified) {
+        ++NumNotInstrumented;
+        ORE.emit([&] {
+          return OptimizationRemarkMissed(DEBUG_TYPE, "NotSimplified", L->getStartLoc(), L->getHeader())
+                 << "function not instrumented: the loop has no preheader or dedicated exits";
+        });
+        loops.clear();
+        break;
+      }
+      loops.push_back(std::move(blocks));
+    }
+    if (loops.empty()) continue;
+
+    numLoops += loops.size();
+    ORE.emit([&] {
+      return OptimizationRemark(DEBUG_TYPE, "Instrumented", &F)
+             << "instrumented " << ore::NV("Loops", unsigned(loops.size())) << " loops";
+    });
+    functions.emplace_back(&F, std::move(loops));
+  }
+  if (functions.empty()) return PreservedAnalyses::all();
+
+  LLVMContext &Ctx = M.getContext();
+  Type *Int64Ty = Type::getInt64Ty(Ctx);
+  PointerType *PtrTy = PointerType::getUnqual(Ctx);
+
+  // Counters of each thread: set to 1 once the thread has registered them with
+  // LoopProfileRT, then the counters of every loop
+  auto *countersTy = ArrayType::get(Int64Ty, 1 + NumLoopCounters * numLoops);
+  auto *counters = new GlobalVariable(M, countersTy, false, GlobalValue::InternalLinkage,
+                                      Constant::getNullValue(countersTy), "__loopprof_counters",
+                                      nullptr, GlobalValue::GeneralDynamicTLSModel);
+
+  // Descriptor of the module, read by LoopProfileRT:
+  //   struct { struct { const char *Name; uint64_t NumLoops; } *Functions;
+  //            uint64_t NumFunctions; uint64_t NumCounters; }
+  auto *functionDescTy = StructType::get(PtrTy, Int64Ty);
+  SmallVector<Constant*, 16> functionDescs;
+  for (auto &[F, loops] : functions) {
+    auto *name = new GlobalVariable(M, ArrayType::get(Type::getInt8Ty(Ctx), F->getName().size() + 1), true,
+                                    GlobalValue::PrivateLinkage, ConstantDataArray::getString(Ctx, F->getName()),
+                                    "__loopprof_name");
+    name->setUnnamedAddr(GlobalValue::UnnamedAddr::Global);
+    functionDescs.push_back(ConstantStruct::get(functionDescTy, {name, ConstantInt::get(Int64Ty, loops.size())}));
+  }
+  auto *functionsTy = ArrayType::get(functionDescTy, functionDescs.size());
+  auto *functionsDesc = new GlobalVariable(M, functionsTy, true, GlobalValue::PrivateLinkage,
+                                           ConstantArray::get(functionsTy, functionDescs), "__loopprof_functions");
+  auto *moduleDescTy = StructType::get(PtrTy, Int64Ty, Int64Ty);
+  auto *moduleDesc = new GlobalVariable(M, moduleDescTy, true, GlobalValue::PrivateLinkage,
+      ConstantStruct::get(moduleDescTy, {functionsDesc, ConstantInt::get(Int64Ty, functionDescs.size()),
+                                         ConstantInt::get(Int64Ty, countersTy->getNumElements())}),
+      "__loopprof_module");
+
+  // Registered before main, so that the loops never entered are in the profile
+  FunctionCallee registerModule = M.getOrInsertFunction("__loopprof_register_module",
+                                                        Type::getVoidTy(Ctx), PtrTy);
+  FunctionCallee registerThread = M.getOrInsertFunction("__loopprof_register_thread",
+                                                        Type::getVoidTy(Ctx), PtrTy, PtrTy);
+  Function *ctor = Function::Create(FunctionType::get(Type::getVoidTy(Ctx), false),
+                                    GlobalValue::InternalLinkage, "__loopprof_module_ctor", M);
+  IRBuilder<> ctorBuilder(BasicBlock::Create(Ctx, "", ctor));
+  ctorBuilder.CreateCall(registerModule, moduleDesc);
+  ctorBuilder.CreateRetVoid();
+  appendToGlobalCtors(M, ctor, 65535);
+
+  MDNode *unlikely = MDBuilder(Ctx).createBranchWeights(1, (1U << 20) - 1);
+  unsigned counter = 1;
+  for (auto &[F, loops] : functions) {
+    // Address of the counters of the thread, taken once in the preheader of
+    // each outermost loop
+    Value *threadCounters = nullptr;
+
+    for (LoopBlocks &blocks : loops) {
+      IRBuilder<> B(blocks.preheader->getTerminator());
+      if (blocks.outermost) {
+        threadCounters = B.CreateThreadLocalAddress(counters);
+        Value *unregistered = B.CreateICmpEQ(B.CreateLoad(Int64Ty, threadCounters), ConstantInt::get(Int64Ty, 0));
+        Instruction *then = SplitBlockAndInsertIfThen(unregistered, blocks.preheader->getTerminator(), false, unlikely);
+        IRBuilder<>(then).CreateCall(registerThread, {moduleDesc, threadCounters});
+        // After the split, the preheader ends in the branch on unregistered
+        B.SetInsertPoint(then->getParent()->getSingleSuccessor()->getTerminator());
+      }
+
+      auto increment = [&](IRBuilder<> &B, LoopCounter c, Value *amount) {
+        Value *ptr = B.CreateConstInBoundsGEP1_64(Int64Ty, threadCounters, counter + c);
+        B.CreateStore(B.CreateAdd(B.CreateLoad(Int64Ty, ptr), amount), ptr);
+      };
+
+      increment(B, Entries, ConstantInt::get(Int64Ty, 1));
+      Value *start = B.CreateIntrinsic(Intrinsic::readcyclecounter, {}, {});
+
+      IRBuilder<> headerBuilder(blocks.header, blocks.header->getFirstInsertionPt());
+      increment(headerBuilder, Iterations, ConstantInt::get(Int64Ty, 1));
+
+      for (BasicBlock *exit : blocks.exits) {
+        IRBuilder<> exitBuilder(exit, exit->getFirstInsertionPt());
+        Value *end = exitBuilder.CreateIntrinsic(Intrinsic::readcyclecounter, {}, {});
+        increment(exitBuilder, Cycles, exitBuilder.CreateSub(end, start));
+      }
+
+      counter += NumLoopCounters;
+      ++NumInstrumentedLoops;
+    }
+  }
+
+  return PreservedAnalyses::none();
+}
+
+PassPluginLibraryInfo getLoopProfilePluginInfo() {
+  return {
+    LLVM_PLUGIN_API_VERSION,
+    "LoopProfile",
+    "v1.0",
+    [](PassBuilder &PB) {
+      PB.registerPipelineParsingCallback(
+        [](StringRef Name, ModulePassManager &MPM,
+           ArrayRef<PassBuilder::PipelineElement>) {
+          if (Name == "loop-profile-instr") {
+            MPM.addPass(LoopProfileInstr());
+            return true;
+          }
+          return false;
+        });
+    }
+  };
+}
@@ -0,0 +1,57 @@
+#ifndef LOOP_PROFILE_H
+#define LOOP_PROFILE_H
+
+#include "llvm/IR/Function.h"
+#include "llvm/IR/IRBuilder.h"
+#include "llvm/IR/Instructions.h"
+#include "llvm/IR/PassManager.h"
+#include "llvm/IR/Module.h"
+#include "llvm/Passes/PassBuilder.h"
+#include "llvm/Passes/PassPlugin.h"
+
+#include "llvm/ADT/SmallPtrSet.h"
+#include "llvm/Analysis/BlockFrequencyInfo.h"
+#include "llvm/Analysis/LoopInfo.h"
+#include "llvm/Analysis/OptimizationRemarkEmitter.h"
+#include "llvm/Analysis/ProfileSummaryInfo.h"
+
+namespace llvm {
+
+// Counts, for every loop, how many times it is entered, its iterations and
+// the cycles spent in it. Each thread counts in its own copy of the counters;
+// the programs are linked with LoopProfileRT, which adds them up and writes
+// the profile when the process exits.
+//
+// Needs the loops in simplified form: the functions with other loops are not
+// instrumented.
+class LoopProfileInstr : public PassInfoMixin<LoopProfileInstr> {
+    public:
+        PreservedAnalyses run(Module &M, ModuleAnalysisManager &MAM);
+    };
+
+// The hot loops of a function, for the passes that only transform those.
+// They come from the profile of -loop-profile-use, or else from the PGO
+// counts of the function. Without either, every loop is hot.
+//
+// The profile of a function is used only if it has the same number of loops
+// as when it was instrumented; the loops are matched in preorder.
+class LoopHotness {
+    public:
+        LoopHotness() = default;
+        // BFI and PSI may be null: the PGO counts are not used
+        LoopHotness(Function &F, LoopInfo &LI, BlockFrequencyInfo *BFI, ProfileSummaryInfo *PSI);
+        // Computes BFI only if the function has PGO counts
+        static LoopHotness get(Function &F, FunctionAnalysisManager &FAM);
+
+        bool isHot(const Loop *L) const { return !coldHeaders.contains(L->getHeader()); }
+
+    private:
+        // Headers, which stay valid while other loops are transformed
+        SmallPtrSet<const BasicBlock*, 8> coldHeaders;
+    };
+}
+
+// Pipeline names of loop-profile-instr, registered by the unified plugin
+llvm::PassPluginLibraryInfo getLoopProfilePluginInfo();
+
+#endif
@@ -0,0 +1,106 @@
+// Runtime of loop-profile-instr, linked into the instrumented programs.
+//
+// Every thread counts in its own copy of the counters of each module, and adds
+// them to the totals of the process when it exits. The profile is written when
+// the process exits, to $LOOP_PROFILE_FILE (default: default.loopprof).
+#include <cinttypes>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace {
+
+// Descriptor of an instrumented module, emitted by loop-profile-instr
+struct FunctionDesc {
+  const char *Name;
+  uint64_t NumLoops;
+};
+struct ModuleDesc {
+  const FunctionDesc *Functions;
+  uint64_t NumFunctions;
+  // The flag of the thread, then three counters per loop
+  uint64_t NumCounters;
+};
+
+class Profile {
+public:
+  ~Profile() { write(); }
+
+  void addModule(const ModuleDesc *Desc) {
+    std::lock_guard<std::mutex> Lock(Mutex);
+    getTotals(Desc);
+  }
+
+  void addThreadCounters(const ModuleDesc *Desc, const uint64_t *Counters) {
+    std::lock_guard<std::mutex> Lock(Mutex);
+    std::vector<uint64_t> &Totals = getTotals(Desc);
+    for (uint64_t I = 1; I < Desc->NumCounters; ++I)
+      Totals[I] += Counters[I];
+  }
+
+private:
+  std::vector<uint64_t> &getTotals(const ModuleDesc *Desc) {
+    for (auto &Module : Modules)
+      if (Module.first == Desc) return Module.second;
+    Modules.emplace_back(Desc, std::vector<uint64_t>(Desc->NumCounters));
+    return Modules.back().second;
+  }
+
+  void write() {
+    const char *Path = getenv("LOOP_PROFILE_FILE");
+    if (!Path || !*Path) Path = "default.loopprof";
+
+    FILE *File = fopen(Path, "w");
+    if (!File) {
+      fprintf(stderr, "loop profile: cannot write %s\n", Path);
+      return;
+    }
+
+    fprintf(File, "# loop profile\n");
+    for (auto &[Desc, Totals] : Modules) {
+      const uint64_t *Counter = Totals.data() + 1;
+      for (uint64_t F = 0; F < Desc->NumFunctions; ++F) {
+        fprintf(File, "%s %" PRIu64 "\n", Desc->Functions[F].Name, Desc->Functions[F].NumLoops);
+        for (uint64_t L = 0; L < Desc->Functions[F].NumLoops; ++L, Counter += 3)
+          fprintf(File, "%" PRIu64 " %" PRIu64 " %" PRIu64 "\n", Counter[0], Counter[1], Counter[2]);
+      }
+    }
+    fclose(File);
+  }
+
+  std::mutex Mutex;
+  std::vector<std::pair<const ModuleDesc*, std::vector<uint64_t>>> Modules;
+};
+
+// Constructed by the constructor of the first instrumented module: destroyed
+// after the counters of the main thread
+Profile &getProfile() {
+  static Profile P;
+  return P;
+}
+
+// Counters of the thread, added to the profile when it exits
+struct ThreadCounters {
+  ~ThreadCounters() {
+    for (auto &[Desc, Counters] : Modules)
+      getProfile().addThreadCounters(Desc, Counters);
+  }
+
+  std::vector<std::pair<const ModuleDesc*, const uint64_t*>> Modules;
+};
+thread_local ThreadCounters Thread;
+
+} // namespace
+
+extern "C" void __loopprof_register_module(const ModuleDesc *Desc) {
+  getProfile().addModule(Desc);
+}
+
+// Called the first time the thread enters an instrumented loop of the module
+extern "C" void __loopprof_register_thread(const ModuleDesc *Desc, uint64_t *Counters) {
+  Counters[0] = 1;
+  Thread.Modules.emplace_back(Desc, Counters);
+}
@@ -0,0 +1,43 @@
+#!/bin/bash
+# Runtime benchmark of every pass on the test/cpp functions of the assignments:
+# one JSON report per pass in $BENCH_DIR (see driver/Bench.cpp)
+
+BUILD_DIR=${BUILD_DIR:-"build"}
+BENCH_DIR=${BENCH_DIR:-"bench"}
+LL_DIR="$BENCH_DIR/ll"
+mkdir -p "$LL_DIR"
+
+for file in assignment-0*/test/cpp/*.cpp; do
+    [ -e "$file" ] || continue
+
+    ASSIGNMENT=$(basename "$(dirname "$(dirname "$(dirname "$file")")")")
+    BASENAME="$ASSIGNMENT-$(basename "$file" .cpp)"
+
+    # Same input IR as the run_opt.sh scripts
+    clang -S -emit-llvm -Xclang -disable-O0-optnone -O0 "$file" -o "$LL_DIR/$BASENAME.mem.ll"
+    opt -S -p mem2reg "$LL_DIR/$BASENAME.mem.ll" -o "$LL_DIR/$BASENAME.ll"
+    rm "$LL_DIR/$BASENAME.mem.ll"
+done
+
+# Report name and pipeline of every pass
+PIPELINES=(
+    "local-opts:local-opts"
+    "SCCP-opt:SCCP-opt"
+    "VBE-hoist:VBE-hoist"
+    "LICM-opt:loop-simplify,loop-rotate,LICM-opt"
+    "LoopUnswitch-opt:loop-simplify,lcssa,LoopUnswitch-opt"
+    "LoopFusion-opt:loop-simplify,lcssa,LoopFusion-opt"
+    "LoopDeletion-opt:loop-simplify,loop-rotate,LICM-opt,lcssa,LoopDeletion-opt"
+    "IVSR-opt:loop-simplify,IVSR-opt"
+)
+
+STATUS=0
+for entry in "${PIPELINES[@]}"; do
+    NAME=${entry%%:*}
+    PASSES=${entry#*:}
+
+    "$BUILD_DIR/pass-bench" -passes="$PASSES" -o "$BENCH_DIR/$NAME.json" "$LL_DIR"/*.ll > /dev/null || STATUS=1
+    echo "Completed: $NAME"
+done
+
+exit $STATUS